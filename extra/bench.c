@@ -0,0 +1,1509 @@
+/**
+ * Micro-benchmarks for the hot paths of `libSSD1306`.
+ *
+ * The benchmarks run natively against a ctx whose callbacks only count the
+ * bytes they are handed, so the numbers measure the library's own overhead and
+ * not the speed of a bus. Results are printed to stdout.
+ */
+
+#if defined(SSD1306_HAVE_PTHREADS)
+/* clock_gettime() */
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ssd1306/blit.h"
+#include "ssd1306/bus.h"
+#include "ssd1306/canvas.h"
+#include "ssd1306/chart.h"
+#include "ssd1306/console.h"
+#include "ssd1306/draw.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/flip.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/font.h"
+#include "ssd1306/gray.h"
+#include "ssd1306/image.h"
+#include "ssd1306/label_cache.h"
+#include "ssd1306/marquee.h"
+#include "ssd1306/num_field.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/printf.h"
+#include "ssd1306/rle.h"
+#include "ssd1306/scale.h"
+#include "ssd1306/shadow.h"
+#include "ssd1306/ssd1306.h"
+#include "ssd1306/transition.h"
+#include "ssd1306/transpose.h"
+#include "ssd1306/viewport.h"
+#include "ssd1306/vscroll.h"
+#include "ssd1306/vt.h"
+
+#define ARR_LEN(arr) (sizeof(arr) / sizeof(arr[0]))
+
+/**
+ * Bytes and transfers seen by the counting callbacks.
+ */
+struct bus_stats {
+    unsigned long cmds;
+    unsigned long data;
+    unsigned long transfers;
+    uint8_t checksum;
+};
+
+static enum ssd1306_err
+count_cmd(struct ssd1306_ctx *ctx, uint8_t cmd)
+{
+    struct bus_stats *stats = ctx->user_ctx;
+
+    stats->cmds++;
+    stats->checksum ^= cmd;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+count_data(struct ssd1306_ctx *ctx, uint8_t data)
+{
+    struct bus_stats *stats = ctx->user_ctx;
+
+    stats->data++;
+    stats->transfers++;
+    stats->checksum ^= data;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+count_data_list(struct ssd1306_ctx *ctx, const uint8_t *data_list,
+                size_t data_list_len)
+{
+    struct bus_stats *stats = ctx->user_ctx;
+
+    for (size_t i = 0; i < data_list_len; i++) {
+        stats->checksum ^= data_list[i];
+    }
+
+    stats->data += data_list_len;
+    stats->transfers++;
+
+    return SSD1306_OK;
+}
+
+static struct bus_stats stats;
+
+static struct ssd1306_ctx ctx = {
+    .send_cmd = count_cmd,
+    .write_data = count_data,
+    .write_data_list = count_data_list,
+    .user_ctx = &stats,
+    .width = 128,
+    .height = 64,
+};
+
+static void
+reset_stats(void)
+{
+    stats = (struct bus_stats){0};
+}
+
+static double
+seconds_since(clock_t start)
+{
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void
+check(enum ssd1306_err err, const char *what)
+{
+    if (err != SSD1306_OK) {
+        fprintf(stderr, "%s failed with %d\n", what, err);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Size and decode cost of the compressed `font8x8_basic`.
+ */
+static void
+bench_rle(void)
+{
+    const struct ssd1306_font *font = &ssd1306_font8x8_basic;
+    const size_t raw_len = (size_t)font->num_glyphs * font->width * font->pages;
+    static uint8_t encoded[2048];
+    size_t encoded_len;
+    const long iterations = 20000;
+
+    printf("== rle: font8x8_basic ==\n");
+    printf("raw                      %5zu bytes\n", raw_len);
+
+    check(ssd1306_rle_encode(font->glyphs, raw_len, encoded, sizeof(encoded),
+                             &encoded_len),
+          "ssd1306_rle_encode");
+    printf("single stream            %5zu bytes (%.1f%%)\n", encoded_len,
+           100.0 * encoded_len / raw_len);
+
+    static const uint8_t block_sizes[] = {1, 4, 8, 16, 32};
+
+    for (size_t i = 0; i < ARR_LEN(block_sizes); i++) {
+        static uint16_t offsets[SSD1306_RLE_NUM_BLOCK_OFFSETS(256, 1)];
+        static uint8_t font_data[2048];
+        struct ssd1306_rle_font rle_font;
+        size_t num_offsets =
+            SSD1306_RLE_NUM_BLOCK_OFFSETS(font->num_glyphs, block_sizes[i]);
+
+        enum ssd1306_err err =
+            ssd1306_rle_encode_font(font, block_sizes[i], font_data,
+                                    sizeof(font_data), offsets, &rle_font);
+
+        if (err == SSD1306_RLE_NOT_SMALLER) {
+            printf("%2u glyphs/block rejected, no smaller than raw\n",
+                   block_sizes[i]);
+            continue;
+        }
+
+        check(err, "ssd1306_rle_encode_font");
+
+        size_t data_len = offsets[num_offsets - 1];
+        size_t total_len = data_len + num_offsets * sizeof(offsets[0]);
+
+        reset_stats();
+        clock_t start = clock();
+
+        for (long n = 0; n < iterations / 16; n++) {
+            for (unsigned c = 0; c < font->num_glyphs; c++) {
+                check(ssd1306_write_rle_char(&ctx, &rle_font, (uint8_t)c),
+                      "ssd1306_write_rle_char");
+            }
+        }
+
+        double elapsed = seconds_since(start);
+
+        printf("%2u glyphs/block %5zu + %3zu index = %5zu bytes (%.1f%%), "
+               "%6.2f ns/glyph\n",
+               block_sizes[i], data_len, total_len - data_len, total_len,
+               100.0 * total_len / raw_len,
+               1e9 * elapsed / ((double)(iterations / 16) * font->num_glyphs));
+    }
+
+    /*
+     * What actually lands in flash: the const tables of the shipped fonts.
+     * The encoded font only saves flash if nothing references the raw one.
+     */
+    const struct ssd1306_rle_font *rle_font = &ssd1306_rle_font8x8_basic;
+    size_t num_offsets = SSD1306_RLE_NUM_BLOCK_OFFSETS(
+        rle_font->num_glyphs, rle_font->glyphs_per_block);
+    size_t flash_len = rle_font->block_offsets[num_offsets - 1]
+                       + num_offsets * sizeof(rle_font->block_offsets[0]);
+
+    printf("flash: raw %zu bytes, ssd1306_rle_font8x8_basic %zu bytes, "
+           "%zu bytes saved\n",
+           raw_len, flash_len, raw_len - flash_len);
+
+    reset_stats();
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_write_rle(&ctx, encoded, encoded_len),
+              "ssd1306_write_rle");
+    }
+
+    double rle_elapsed = seconds_since(start);
+    unsigned long rle_bytes = stats.data;
+
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_write_data_list(&ctx, font->glyphs, raw_len),
+              "ssd1306_write_data_list");
+    }
+
+    double raw_elapsed = seconds_since(start);
+
+    printf("stream decode            %6.3f ns/byte\n",
+           1e9 * rle_elapsed / rle_bytes);
+    printf("raw write_data_list      %6.3f ns/byte\n",
+           1e9 * raw_elapsed / stats.data);
+    printf("\n");
+}
+
+/**
+ * Cost of redrawing a clock at every supported scale.
+ */
+static void
+bench_scaled_text(void)
+{
+    static const uint8_t clock_str[] = "12:34";
+    const long iterations = 20000;
+
+    printf("== scaled text: \"%s\" ==\n", clock_str);
+
+    for (uint8_t scale = 1; scale <= SSD1306_MAX_TEXT_SCALE; scale++) {
+        reset_stats();
+        clock_t start = clock();
+
+        for (long n = 0; n < iterations; n++) {
+            /* 4x only fits 4 characters across a 128 column display. */
+            check(ssd1306_write_str_scaled(&ctx, SSD1306_COL_0, SSD1306_PAGE_0,
+                                           &clock_str[scale == 4], scale),
+                  "ssd1306_write_str_scaled");
+        }
+
+        double elapsed = seconds_since(start);
+
+        printf("%ux %5lu bytes/redraw %8.1f ns/redraw %6.3f ns/byte\n", scale,
+               stats.data / iterations, 1e9 * elapsed / iterations,
+               1e9 * elapsed / stats.data);
+    }
+
+    printf("\n");
+}
+
+/**
+ * Redrawing a dashboard's labels through the label cache versus rendering them
+ * every time.
+ */
+static void
+bench_label_cache(void)
+{
+    static const char *const labels[] = {"TEMP", "RPM", "degC", "kPa", "V"};
+    static struct ssd1306_label_entry entries[8];
+    struct ssd1306_label_cache cache;
+    const struct ssd1306_label_style style = {.scale = 1, .inverted = false};
+    const long iterations = 200000;
+
+    ssd1306_label_cache_init(&cache, entries, ARR_LEN(entries));
+
+    printf("== label cache: %zu labels ==\n", ARR_LEN(labels));
+
+    reset_stats();
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        const uint8_t *label = (const uint8_t *)labels[n % ARR_LEN(labels)];
+
+        check(ssd1306_write_label(&ctx, &cache, SSD1306_COL_0, SSD1306_PAGE_0,
+                                  label, style),
+              "ssd1306_write_label");
+    }
+
+    double cached_elapsed = seconds_since(start);
+    unsigned long cached_transfers = stats.transfers;
+
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        const uint8_t *label = (const uint8_t *)labels[n % ARR_LEN(labels)];
+
+        check(ssd1306_write_str_scaled(&ctx, SSD1306_COL_0, SSD1306_PAGE_0,
+                                       label, 1),
+              "ssd1306_write_str_scaled");
+    }
+
+    double uncached_elapsed = seconds_since(start);
+
+    printf("cached   %7.1f ns/label %4.2f transfers/label (%lu hits, "
+           "%lu misses)\n",
+           1e9 * cached_elapsed / iterations,
+           (double)cached_transfers / iterations, (unsigned long)cache.hits,
+           (unsigned long)cache.misses);
+    printf("uncached %7.1f ns/label %4.2f transfers/label\n",
+           1e9 * uncached_elapsed / iterations,
+           (double)stats.transfers / iterations);
+    printf("\n");
+}
+
+/**
+ * Bus traffic of a counter shown in a numeric field versus rewriting the whole
+ * number every time.
+ */
+static void
+bench_num_field(void)
+{
+    struct ssd1306_num_field field;
+    const long iterations = 100000;
+
+    printf("== numeric field: counting to %ld ==\n", iterations);
+
+    check(ssd1306_num_field_init(&field, SSD1306_COL_0, SSD1306_PAGE_0, 6, 0, 2,
+                                 ' '),
+          "ssd1306_num_field_init");
+
+    reset_stats();
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_num_field_update(&ctx, &field, (int32_t)n),
+              "ssd1306_num_field_update");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("incremental %6.1f data bytes/update %4.1f cmd bytes/update "
+           "%7.1f ns/update\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations);
+    printf("full line   %6.1f data bytes/update %4.1f cmd bytes/update\n",
+           (double)field.len * 8 * 2 * 2, 6.0);
+    printf("\n");
+}
+
+/**
+ * ssd1306_printf versus formatting with the C library first.
+ */
+static void
+bench_printf(void)
+{
+    const long iterations = 200000;
+
+    printf("== printf: \"T=%%5.1f C %%3d%%%%\" ==\n");
+
+    reset_stats();
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_printf(&ctx, "T=%5.1f C %3d%%", 21.5 + (n % 100) * 0.1,
+                             (int)(n % 101)),
+              "ssd1306_printf");
+    }
+
+    double direct_elapsed = seconds_since(start);
+    unsigned long direct_transfers = stats.transfers;
+
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        char str[32];
+
+        snprintf(str, sizeof(str), "T=%5.1f C %3d%%", 21.5 + (n % 100) * 0.1,
+                 (int)(n % 101));
+        check(ssd1306_write_str(&ctx, (const uint8_t *)str),
+              "ssd1306_write_str");
+    }
+
+    double libc_elapsed = seconds_since(start);
+
+    printf("ssd1306_printf          %7.1f ns/call %4.2f transfers/call\n",
+           1e9 * direct_elapsed / iterations,
+           (double)direct_transfers / iterations);
+    printf("snprintf + write_str    %7.1f ns/call %4.2f transfers/call\n",
+           1e9 * libc_elapsed / iterations,
+           (double)stats.transfers / iterations);
+    printf("\n");
+}
+
+/**
+ * Glyphs per second drawn into the framebuffer on a page boundary versus
+ * straddling two pages.
+ */
+static void
+bench_fb_text(void)
+{
+    static uint8_t buf[SSD1306_FB_LEN(128, 64)];
+    static const uint8_t str[] = "The quick brown ";
+    const long iterations = 200000;
+    struct ssd1306_fb fb;
+    const int16_t rows[] = {8, 11};
+
+    printf("== framebuffer text: \"%s\" ==\n", str);
+
+    check(ssd1306_fb_init(&fb, buf, 128, 64), "ssd1306_fb_init");
+
+    for (size_t i = 0; i < ARR_LEN(rows); i++) {
+        clock_t start = clock();
+
+        for (long n = 0; n < iterations; n++) {
+            check(ssd1306_fb_draw_str(&fb, &ssd1306_font8x8_basic, 0, rows[i],
+                                      str, n & 1),
+                  "ssd1306_fb_draw_str");
+        }
+
+        double elapsed = seconds_since(start);
+
+        printf("y = %2d (%s) %6.2f Mglyphs/s\n", rows[i],
+               rows[i] % SSD1306_ROWS_PER_PAGE == 0 ? "aligned  " : "unaligned",
+               (double)(iterations * (sizeof(str) - 1)) / elapsed / 1e6);
+    }
+
+    reset_stats();
+    check(ssd1306_fb_flush(&ctx, &fb), "ssd1306_fb_flush");
+
+    printf("flush       %6lu data bytes %4lu cmd bytes\n", stats.data,
+           stats.cmds);
+    printf("\n");
+}
+
+/**
+ * A 32x32 sprite blitted at a page boundary and off one versus drawn a pixel
+ * at a time.
+ */
+static void
+bench_blit(void)
+{
+    static uint8_t buf[SSD1306_FB_LEN(128, 64)];
+    static uint8_t sprite_data[SSD1306_BITMAP_LEN(32, 32)];
+    const struct ssd1306_bitmap sprite = {sprite_data, 32, 32};
+    const long iterations = 200000;
+    struct ssd1306_fb fb;
+    const struct {
+        const char *name;
+        int16_t y;
+        enum ssd1306_rop rop;
+    } cases[] = {
+        {"copy y = 16", 16, SSD1306_ROP_COPY},
+        {"copy y = 19", 19, SSD1306_ROP_COPY},
+        {"xor  y = 16", 16, SSD1306_ROP_XOR},
+        {"xor  y = 19", 19, SSD1306_ROP_XOR},
+    };
+
+    printf("== blit: 32x32 sprite ==\n");
+
+    for (size_t i = 0; i < sizeof(sprite_data); i++) {
+        sprite_data[i] = (uint8_t)(i * 37);
+    }
+
+    check(ssd1306_fb_init(&fb, buf, 128, 64), "ssd1306_fb_init");
+
+    for (size_t i = 0; i < ARR_LEN(cases); i++) {
+        clock_t start = clock();
+
+        for (long n = 0; n < iterations; n++) {
+            check(ssd1306_fb_blit(&fb, &sprite, (int16_t)(n & 63), cases[i].y,
+                                  32, 32, cases[i].rop),
+                  "ssd1306_fb_blit");
+        }
+
+        printf("%s    %7.1f ns/blit\n", cases[i].name,
+               1e9 * seconds_since(start) / iterations);
+    }
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations / 16; n++) {
+        for (int16_t row = 0; row < 32; row++) {
+            for (int16_t col = 0; col < 32; col++) {
+                uint8_t byte = sprite_data[(row / 8) * 32 + col];
+
+                if ((byte >> (row % 8)) & 0x01) {
+                    ssd1306_fb_set_pixel(&fb, (int16_t)(col + (n & 63)),
+                                         (int16_t)(row + 19),
+                                         SSD1306_COLOR_INVERT);
+                }
+            }
+        }
+    }
+
+    printf("xor  per pixel   %7.1f ns/blit\n",
+           1e9 * seconds_since(start) / (iterations / 16));
+    printf("\n");
+}
+
+/**
+ * Span-based shapes versus the same pixels drawn one at a time.
+ */
+static void
+bench_draw(void)
+{
+    static uint8_t buf[SSD1306_FB_LEN(128, 64)];
+    const long iterations = 100000;
+    struct ssd1306_fb fb;
+
+    printf("== drawing: shapes ==\n");
+
+    check(ssd1306_fb_init(&fb, buf, 128, 64), "ssd1306_fb_init");
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_fill_rect(&fb, 10, 3, 100, 50, SSD1306_COLOR_INVERT);
+    }
+
+    printf("fill_rect 100x50      %7.1f ns/call\n",
+           1e9 * seconds_since(start) / iterations);
+
+    start = clock();
+
+    for (long n = 0; n < iterations / 16; n++) {
+        for (int16_t y = 3; y < 53; y++) {
+            for (int16_t x = 10; x < 110; x++) {
+                ssd1306_fb_set_pixel(&fb, x, y, SSD1306_COLOR_INVERT);
+            }
+        }
+    }
+
+    printf("  per pixel           %7.1f ns/call\n",
+           1e9 * seconds_since(start) / (iterations / 16));
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_fill_circle(&fb, 64, 32, 25, SSD1306_COLOR_INVERT);
+    }
+
+    printf("fill_circle r = 25    %7.1f ns/call\n",
+           1e9 * seconds_since(start) / iterations);
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_circle(&fb, 64, 32, 25, SSD1306_COLOR_INVERT);
+    }
+
+    printf("circle r = 25         %7.1f ns/call\n",
+           1e9 * seconds_since(start) / iterations);
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_fill_round_rect(&fb, 4, 4, 120, 40, 6,
+                                   SSD1306_COLOR_INVERT);
+    }
+
+    printf("fill_round_rect       %7.1f ns/call\n",
+           1e9 * seconds_since(start) / iterations);
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        int16_t y = (int16_t)(n & 63);
+
+        ssd1306_fb_line(&fb, 0, y, 127, 63 - y, SSD1306_COLOR_INVERT);
+    }
+
+    printf("line across           %7.1f ns/call\n",
+           1e9 * seconds_since(start) / iterations);
+    printf("\n");
+}
+
+/**
+ * The bit at a time loop of rotate_8x8_bit_plus_90 in `extra/rotate.c`,
+ * without the flip. It computes the same transpose as ssd1306_transpose_8x8.
+ */
+static void
+transpose_bit_loop(const uint8_t *in, uint8_t *out)
+{
+    for (size_t i = 0; i < 8; i++) {
+        uint8_t tmp = 0x00;
+
+        for (int j = 7; j >= 0; j--) {
+            tmp |= ((in[j] >> i) & 0x01) << j;
+        }
+
+        out[i] = tmp;
+    }
+}
+
+/**
+ * 8x8 transposes: the bit loop of `extra/rotate.c` versus the SWAR kernel and
+ * its SIMD batch version, and a whole row-major frame converted to pages.
+ */
+static void
+bench_transpose(void)
+{
+    static uint8_t in[16 * 8];
+    static uint8_t out[16 * 8];
+    static uint8_t frame[128 / 8 * 64];
+    static uint8_t pages[128 * 64 / 8];
+    const long iterations = 200000;
+
+    printf("== transpose: 16 blocks of 8x8 ==\n");
+
+    for (size_t i = 0; i < sizeof(in); i++) {
+        in[i] = (uint8_t)(i * 73 + 5);
+    }
+
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        for (size_t block = 0; block < 16; block++) {
+            transpose_bit_loop(&in[block * 8], &out[block * 8]);
+        }
+
+        in[n & 127] ^= out[(n + 1) & 127];
+    }
+
+    printf("bit loop      %7.2f ns/block\n",
+           1e9 * seconds_since(start) / (iterations * 16.0));
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        for (size_t block = 0; block < 16; block++) {
+            ssd1306_transpose_8x8(&in[block * 8], &out[block * 8]);
+        }
+
+        in[n & 127] ^= out[(n + 1) & 127];
+    }
+
+    printf("swar          %7.2f ns/block\n",
+           1e9 * seconds_since(start) / (iterations * 16.0));
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_transpose_8x8_batch(in, out, 16);
+        in[n & 127] ^= out[(n + 1) & 127];
+    }
+
+    printf("batch         %7.2f ns/block\n",
+           1e9 * seconds_since(start) / (iterations * 16.0));
+
+    start = clock();
+
+    for (long n = 0; n < iterations / 10; n++) {
+        ssd1306_rows_to_pages(frame, 128 / 8, 128, 64, SSD1306_MSB_FIRST,
+                              pages);
+        frame[n & 1023] ^= pages[(n + 1) & 1023];
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("128x64 frame  %7.1f ns/frame %6.1f MB/s\n",
+           1e9 * elapsed / (iterations / 10),
+           sizeof(frame) * (double)(iterations / 10) / elapsed / 1e6);
+    printf("\n");
+}
+
+/**
+ * Flushing a row-major canvas, which transposes on the way out, versus
+ * flushing a page-major framebuffer.
+ */
+static void
+bench_canvas(void)
+{
+    static uint8_t canvas_buf[SSD1306_CANVAS_LEN(128, 64)];
+    static uint8_t fb_buf[SSD1306_FB_LEN(128, 64)];
+    const long iterations = 100000;
+    struct ssd1306_canvas canvas;
+    struct ssd1306_fb fb;
+
+    printf("== canvas: flush ==\n");
+
+    check(ssd1306_canvas_init(&canvas, canvas_buf, 128, 64),
+          "ssd1306_canvas_init");
+    check(ssd1306_fb_init(&fb, fb_buf, 128, 64), "ssd1306_fb_init");
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_canvas_mark_all_dirty(&canvas);
+        check(ssd1306_canvas_flush(&ctx, &canvas), "ssd1306_canvas_flush");
+    }
+
+    printf("canvas full frame    %7.1f ns/flush\n",
+           1e9 * seconds_since(start) / iterations);
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_mark_all_dirty(&fb);
+        check(ssd1306_fb_flush(&ctx, &fb), "ssd1306_fb_flush");
+    }
+
+    printf("fb full frame        %7.1f ns/flush\n",
+           1e9 * seconds_since(start) / iterations);
+
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_canvas_set_pixel(&canvas, (int16_t)(n & 127), 20,
+                                 SSD1306_COLOR_INVERT);
+        check(ssd1306_canvas_flush(&ctx, &canvas), "ssd1306_canvas_flush");
+    }
+
+    printf("canvas one pixel     %7.1f ns/flush\n",
+           1e9 * seconds_since(start) / iterations);
+    printf("\n");
+}
+
+/**
+ * Importing a 128x64 PGM with each dithering mode.
+ */
+static void
+bench_image(void)
+{
+    static const char header[] = "P5 128 64 255\n";
+    static uint8_t pgm[sizeof(header) - 1 + 128 * 64];
+    static uint8_t dst[SSD1306_BITMAP_LEN(128, 64)];
+    const long iterations = 20000;
+    const struct {
+        const char *name;
+        enum ssd1306_dither dither;
+    } modes[] = {
+        {"threshold      ", SSD1306_DITHER_THRESHOLD},
+        {"ordered        ", SSD1306_DITHER_ORDERED},
+        {"floyd-steinberg", SSD1306_DITHER_FLOYD_STEINBERG},
+    };
+    struct ssd1306_image image;
+    struct ssd1306_bitmap bitmap;
+
+    printf("== image: 128x64 PGM ==\n");
+
+    memcpy(pgm, header, sizeof(header) - 1);
+
+    for (size_t i = 0; i < 128 * 64; i++) {
+        /* A diagonal gradient. */
+        pgm[sizeof(header) - 1 + i] = (uint8_t)((i % 128) + (i / 128) * 2);
+    }
+
+    check(ssd1306_image_parse(pgm, sizeof(pgm), &image),
+          "ssd1306_image_parse");
+
+    for (size_t i = 0; i < ARR_LEN(modes); i++) {
+        clock_t start = clock();
+
+        for (long n = 0; n < iterations; n++) {
+            check(ssd1306_image_to_bitmap(&image, modes[i].dither, false,
+                                          dst, sizeof(dst), &bitmap),
+                  "ssd1306_image_to_bitmap");
+        }
+
+        double elapsed = seconds_since(start);
+
+        printf("%s %8.1f ns/frame %6.1f Mpixels/s\n", modes[i].name,
+               1e9 * elapsed / iterations,
+               128.0 * 64 * iterations / elapsed / 1e6);
+    }
+
+    printf("\n");
+}
+
+/**
+ * Shrinking a 640x480 gray frame to 128x64 with each filter, on one thread
+ * and, when available, on several.
+ */
+static void
+bench_downscale(void)
+{
+    static uint8_t src[640 * 480];
+    static uint8_t dst[SSD1306_BITMAP_LEN(128, 64)];
+    const long iterations = 500;
+    const struct {
+        const char *name;
+        enum ssd1306_scale_filter filter;
+    } filters[] = {
+        {"nearest", SSD1306_SCALE_NEAREST},
+        {"box    ", SSD1306_SCALE_BOX},
+    };
+    struct ssd1306_downscale job = {
+        .src = src,
+        .src_stride = 640,
+        .src_width = 640,
+        .src_height = 480,
+        .width = 128,
+        .height = 64,
+        .dither = SSD1306_DITHER_ORDERED,
+        .dst = dst,
+    };
+
+    printf("== downscale: 640x480 gray to 128x64, ordered dither ==\n");
+
+    for (size_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t)((i % 640) / 3 + (i / 640) / 8);
+    }
+
+    for (size_t i = 0; i < ARR_LEN(filters); i++) {
+        job.filter = filters[i].filter;
+
+        clock_t start = clock();
+
+        for (long n = 0; n < iterations; n++) {
+            check(ssd1306_downscale(&job), "ssd1306_downscale");
+        }
+
+        double elapsed = seconds_since(start);
+
+        printf("%s %8.1f us/frame %8.1f frames/s\n", filters[i].name,
+               1e6 * elapsed / iterations, iterations / elapsed);
+    }
+
+#if defined(SSD1306_HAVE_PTHREADS)
+    /* clock() adds up every thread's time, so measure the wall clock. */
+    struct timespec start;
+    struct timespec end;
+
+    job.filter = SSD1306_SCALE_BOX;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_downscale_parallel(&job, 4),
+              "ssd1306_downscale_parallel");
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    double elapsed = (double)(end.tv_sec - start.tv_sec)
+                     + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("box x4  %8.1f us/frame %8.1f frames/s\n",
+           1e6 * elapsed / iterations, iterations / elapsed);
+#endif
+
+    printf("\n");
+}
+
+/**
+ * Cycling the planes of a 4 bpp image whose gray levels only cover two pages,
+ * like a UI with a gradient bar, against sending every plane whole.
+ */
+static void
+bench_gray(void)
+{
+    static uint8_t gray_buf[SSD1306_GRAY_LEN(128, 64, 4)];
+    static uint8_t shadow_buf[SSD1306_FB_LEN(128, 64)];
+    const long cycles = 20000;
+    const long slots = cycles * 15;
+    struct ssd1306_gray_fb gray;
+    struct ssd1306_shadow shadow;
+    struct ssd1306_gray_sched sched;
+    struct ssd1306_bus_model bus;
+
+    printf("== gray: 4 bpp, 15 slots per cycle, bar over pages 3-4 ==\n");
+
+    check(ssd1306_gray_init(&gray, gray_buf, 128, 64, 4), "ssd1306_gray_init");
+    check(ssd1306_shadow_init(&shadow, shadow_buf, 128, 64),
+          "ssd1306_shadow_init");
+    ssd1306_bus_model_i2c(&bus, 400000);
+
+    for (int16_t y = 24; y < 40; y++) {
+        for (int16_t x = 0; x < 128; x++) {
+            ssd1306_gray_set_pixel(&gray, x, y, (uint8_t)(x / 8));
+        }
+    }
+
+    check(ssd1306_gray_sched_init(&sched, &gray, &shadow, NULL, 0),
+          "ssd1306_gray_sched_init");
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < slots; n++) {
+        check(ssd1306_gray_sched_tick(&ctx, &sched),
+              "ssd1306_gray_sched_tick");
+    }
+
+    double elapsed = seconds_since(start);
+    double data = (double)stats.data / cycles;
+    double cmds = (double)stats.cmds / cycles;
+
+    printf("shadow diff %8.1f data bytes/cycle %6.1f cmd bytes/cycle "
+           "%7.1f ns/slot\n",
+           data, cmds, 1e9 * elapsed / slots);
+    printf("            %8.1f ms/cycle on 400 kHz I2C\n",
+           (ssd1306_bus_cmd_ns(&bus, (size_t)cmds)
+            + 4 * (double)ssd1306_bus_data_ns(&bus, (size_t)data / 4))
+               / 1e6);
+    printf("whole plane %8d data bytes/cycle %6d cmd bytes/cycle\n", 4 * 1024,
+           4 * SSD1306_WINDOW_CMD_LEN);
+    printf("            %8.1f ms/cycle on 400 kHz I2C\n",
+           (ssd1306_bus_cmd_ns(&bus, 4 * SSD1306_WINDOW_CMD_LEN)
+            + 4 * (double)ssd1306_bus_data_ns(&bus, 1024))
+               / 1e6);
+    printf("\n");
+}
+
+/**
+ * Presenting 128x32 frames where a 5x7 counter changes, through the back half
+ * of the display's RAM.
+ */
+static void
+bench_flip(void)
+{
+    static uint8_t shadows[SSD1306_FLIP_LEN(128, 32)];
+    static uint8_t frame[SSD1306_FB_LEN(128, 32)];
+    static struct ssd1306_ctx ctx32 = {
+        .send_cmd = count_cmd,
+        .write_data = count_data,
+        .write_data_list = count_data_list,
+        .user_ctx = &stats,
+        .width = 128,
+        .height = 32,
+    };
+    const long iterations = 200000;
+    struct ssd1306_flip flip;
+
+    printf("== flip: 128x32, 5 changed columns per frame ==\n");
+
+    check(ssd1306_flip_init(&ctx32, &flip, shadows), "ssd1306_flip_init");
+
+    /* Both halves start stale. */
+    check(ssd1306_flip_present(&ctx32, &flip, frame), "ssd1306_flip_present");
+    check(ssd1306_flip_present(&ctx32, &flip, frame), "ssd1306_flip_present");
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        for (size_t x = 0; x < 5; x++) {
+            frame[128 + 60 + x] = (uint8_t)(n + x);
+        }
+
+        check(ssd1306_flip_present(&ctx32, &flip, frame),
+              "ssd1306_flip_present");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("present %6.1f data bytes %4.1f cmd bytes %6.1f ns/frame\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations);
+    printf("\n");
+}
+
+static void
+bench_console(void)
+{
+    static const uint8_t line[] = "sensor 3: 21.5 C\n";
+    const long iterations = 200000;
+    struct ssd1306_console console;
+
+    printf("== console: 16 character log lines, scrolled ==\n");
+
+    check(ssd1306_console_init(&ctx, &console), "ssd1306_console_init");
+
+    /* Fill the screen so every line scrolls. */
+    for (uint8_t row = 0; row < console.rows; row++) {
+        check(ssd1306_console_write(&ctx, &console, line, sizeof(line) - 1),
+              "ssd1306_console_write");
+    }
+
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_console_write(&ctx, &console, line, sizeof(line) - 1),
+              "ssd1306_console_write");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("line    %6.1f data bytes %4.1f cmd bytes %6.1f ns/line "
+           "(redraw: %ld data bytes)\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations, (long)SSD1306_FB_LEN(128, 64));
+    printf("\n");
+}
+
+static void
+bench_vt(void)
+{
+    static struct ssd1306_vt vt;
+    const long iterations = 200000;
+    char frame[64];
+
+    printf("== vt: status screen redrawn with cursor positioning ==\n");
+
+    check(ssd1306_vt_init(&ctx, &vt), "ssd1306_vt_init");
+    reset_stats();
+
+    clock_t start = clock();
+
+    /* Like watch(1): the whole screen is resent, one field changes. */
+    for (long n = 0; n < iterations; n++) {
+        int len = snprintf(frame, sizeof(frame),
+                           "\x1b[H\x1b[7mCPU\x1b[m %5ld\x1b[K\r\nMEM 1234",
+                           n % 100000);
+
+        check(ssd1306_vt_feed(&ctx, &vt, (const uint8_t *)frame, (size_t)len),
+              "ssd1306_vt_feed");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("update  %6.1f data bytes %4.1f cmd bytes %6.1f ns/update\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations);
+    printf("\n");
+}
+
+/**
+ * Simulated time, advanced by the benchmarks that need a frame clock.
+ */
+static uint64_t sim_now_ns;
+
+static uint64_t
+sim_now(void *user)
+{
+    (void)user;
+
+    return sim_now_ns;
+}
+
+static void
+bench_marquee(void)
+{
+    static const uint8_t text[] = "Breaking: libSSD1306 ticker test    ";
+    const long iterations = 200000;
+    struct ssd1306_frame_clock frame_clock;
+    struct ssd1306_marquee marquee;
+
+    printf("== marquee: one page, ticked every scroll step ==\n");
+
+    sim_now_ns = 0;
+    check(ssd1306_frame_clock_init(&frame_clock, &ctx, sim_now, NULL, NULL),
+          "ssd1306_frame_clock_init");
+    check(ssd1306_marquee_init(&ctx, &marquee, &frame_clock, SSD1306_PAGE_0,
+                               SSD1306_2_FRAMES, text, sizeof(text) - 1),
+          "ssd1306_marquee_init");
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        sim_now_ns += 2 * (uint64_t)frame_clock.period_ns;
+        check(ssd1306_marquee_tick(&ctx, &marquee), "ssd1306_marquee_tick");
+    }
+
+    double elapsed = seconds_since(start);
+
+    /* The clock goes out of scope with this function. */
+    check(ssd1306_stop_scrolling(&ctx), "ssd1306_stop_scrolling");
+
+    printf("column  %6.1f data bytes %4.1f cmd bytes %6.1f ns/column "
+           "(page rewrite: %d data bytes)\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations, 128);
+    printf("\n");
+}
+
+static void
+bench_chart(void)
+{
+    const long iterations = 200000;
+    struct ssd1306_bus_model bus;
+    struct ssd1306_chart chart;
+
+    printf("== chart: 4 page sweep, one sample per push ==\n");
+
+    ssd1306_bus_model_i2c(&bus, 400000);
+    check(ssd1306_chart_init(&ctx, &chart, SSD1306_CHART_SWEEP, 4, 4, NULL,
+                             SSD1306_2_FRAMES),
+          "ssd1306_chart_init");
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        /* A slow triangle wave with some noise. */
+        uint8_t value = (uint8_t)((n % 64 < 32 ? n % 32 : 31 - n % 32)
+                                  + (uint8_t)(n * 7) % 3);
+
+        check(ssd1306_chart_push(&ctx, &chart, value), "ssd1306_chart_push");
+    }
+
+    double elapsed = seconds_since(start);
+    uint32_t cmds = (uint32_t)(stats.cmds / iterations);
+    uint32_t data = (uint32_t)((stats.data + iterations - 1) / iterations);
+
+    printf("sample  %6.1f data bytes %4.1f cmd bytes %6.1f ns/sample "
+           "(~%u us on 400 kHz I2C)\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations,
+           (unsigned)((ssd1306_bus_cmd_ns(&bus, cmds)
+                       + ssd1306_bus_data_ns(&bus, data))
+                      / 1000));
+    printf("\n");
+}
+
+/**
+ * A log scrolling under a one page header: write the body's lines, let the
+ * display scroll them, then stop and write the next ones from a later base.
+ */
+static void
+bench_vscroll(void)
+{
+    const long rounds = 20000;
+    struct ssd1306_frame_clock frame_clock;
+    struct ssd1306_vscroll vscroll;
+    unsigned long rows = 0;
+    uint16_t base_line = 0;
+
+    printf("== vscroll: 1 page header, 7 page log ==\n");
+
+    sim_now_ns = 0;
+    check(ssd1306_frame_clock_init(&frame_clock, &ctx, sim_now, NULL, NULL),
+          "ssd1306_frame_clock_init");
+    check(ssd1306_vscroll_init(&ctx, &vscroll, &frame_clock, 1,
+                               SSD1306_2_FRAMES, 1, SSD1306_PAGE_0, false),
+          "ssd1306_vscroll_init");
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < rounds; n++) {
+        for (uint16_t line = base_line;
+             line < base_line + vscroll.body_pages; line++) {
+            uint8_t text[17];
+
+            snprintf((char *)text, sizeof(text), "log line %7u", line);
+
+            enum ssd1306_page page =
+                ssd1306_vscroll_page(&vscroll, base_line, line);
+
+            if (line == base_line && page != vscroll.header_pages) {
+                fprintf(stderr, "line %u isn't at the top of the body\n",
+                        line);
+                exit(EXIT_FAILURE);
+            }
+
+            check(ssd1306_write_str_scaled(&ctx, SSD1306_COL_0, page, text, 1),
+                  "ssd1306_write_str_scaled");
+        }
+
+        check(ssd1306_vscroll_start(&ctx, &vscroll, base_line),
+              "ssd1306_vscroll_start");
+
+        /* Scroll a few lines, one row every 2 frames. */
+        sim_now_ns += (uint64_t)(2 + n % 3) * SSD1306_ROWS_PER_PAGE * 2
+                      * frame_clock.period_ns;
+
+        uint32_t first_row = ssd1306_vscroll_first_row(&vscroll, sim_now_ns);
+
+        check(ssd1306_vscroll_stop(&ctx, &vscroll), "ssd1306_vscroll_stop");
+
+        rows += first_row - (uint32_t)base_line * SSD1306_ROWS_PER_PAGE;
+        base_line = (uint16_t)(first_row / SSD1306_ROWS_PER_PAGE);
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("round   %6.1f data bytes %4.1f cmd bytes %6.1f ns/round "
+           "%5.1f rows scrolled by the display\n",
+           (double)stats.data / rounds, (double)stats.cmds / rounds,
+           1e9 * elapsed / rounds, (double)rows / rounds);
+    printf("\n");
+}
+
+/**
+ * Panning over a 512x256 grid, a stand-in for a map: 8 row pans down the
+ * image and 1 column pans across it.
+ */
+static void
+bench_viewport(void)
+{
+    static uint8_t image[SSD1306_FB_LEN(512, 256)];
+    static uint8_t buf[SSD1306_VIEWPORT_LEN(128)];
+    const long iterations = 20000;
+    struct ssd1306_viewport viewport;
+
+    printf("== viewport: 512x256 grid on 128x64 ==\n");
+
+    for (size_t i = 0; i < sizeof(image); i++) {
+        /* Columns every 32 and a row that moves down from page to page. */
+        image[i] = i % 512 % 32 == 0 ? 0xFF : (uint8_t)(1U << i / 512 % 7);
+    }
+
+    check(ssd1306_viewport_init(&ctx, &viewport, buf, image, 512, 256),
+          "ssd1306_viewport_init");
+    check(ssd1306_viewport_show(&ctx, &viewport, 0, 0),
+          "ssd1306_viewport_show");
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_viewport_show(&ctx, &viewport, 0,
+                                    (uint16_t)(n % 24 * 8)),
+              "ssd1306_viewport_show");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("8 rows  %6.1f data bytes %4.1f cmd bytes %6.1f ns/pan\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations);
+
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_viewport_show(&ctx, &viewport, (uint16_t)(n % 384), 0),
+              "ssd1306_viewport_show");
+    }
+
+    elapsed = seconds_since(start);
+
+    printf("1 col   %6.1f data bytes %4.1f cmd bytes %6.1f ns/pan\n",
+           (double)stats.data / iterations, (double)stats.cmds / iterations,
+           1e9 * elapsed / iterations);
+    printf("redraw  %6ld data bytes\n", (long)SSD1306_FB_LEN(128, 64));
+    printf("\n");
+}
+
+/**
+ * Changing between two random 128x64 screens with each effect, 4 rows or 8
+ * columns a frame and at most 256 bytes a frame. Pushes scroll a column every
+ * 2 frames.
+ */
+static void
+bench_transition(void)
+{
+    static const char *const names[] = {
+        "slide up", "slide down", "wipe left",
+        "wipe right", "push left", "push right",
+    };
+    static uint8_t from[SSD1306_FB_LEN(128, 64)];
+    static uint8_t to[SSD1306_FB_LEN(128, 64)];
+    struct ssd1306_frame_clock frame_clock;
+    struct ssd1306_transition transition;
+
+    printf("== transition: 128x64, 256 bytes per frame ==\n");
+
+    for (size_t i = 0; i < sizeof(from); i++) {
+        from[i] = (uint8_t)(i * 7 + 3);
+        to[i] = (uint8_t)(i * 13 + 5);
+    }
+
+    sim_now_ns = 0;
+    check(ssd1306_frame_clock_init(&frame_clock, &ctx, sim_now, NULL, NULL),
+          "ssd1306_frame_clock_init");
+
+    for (size_t effect = 0; effect < ARR_LEN(names); effect++) {
+        bool done = false;
+        long frames = 0;
+        unsigned long most = 0;
+
+        check(ssd1306_transition_start(&ctx, &transition,
+                                       (enum ssd1306_transition_effect)effect,
+                                       from, to, effect < 2 ? 4 : 8, 256,
+                                       &frame_clock, SSD1306_2_FRAMES),
+              "ssd1306_transition_start");
+        reset_stats();
+
+        while (!done) {
+            unsigned long before = stats.data + stats.cmds;
+
+            sim_now_ns += frame_clock.period_ns;
+            check(ssd1306_transition_tick(&ctx, &transition, &done),
+                  "ssd1306_transition_tick");
+
+            if (stats.data + stats.cmds - before > most) {
+                most = stats.data + stats.cmds - before;
+            }
+            frames++;
+        }
+
+        printf("%-10s %4ld frames %6lu bytes %4lu bytes/frame at most\n",
+               names[effect], frames, stats.data + stats.cmds, most);
+    }
+
+    printf("redraw     %4d frames %6ld bytes %4ld bytes/frame\n", 10,
+           10 * (long)(SSD1306_FB_LEN(128, 64) + SSD1306_WINDOW_CMD_LEN),
+           (long)(SSD1306_FB_LEN(128, 64) + SSD1306_WINDOW_CMD_LEN));
+    printf("\n");
+}
+
+/**
+ * Full frame flushes on a display rotated 0 degrees versus 90 degrees, the
+ * portrait one transposed on the way out, and versus rotating the portrait
+ * framebuffer a pixel at a time into a landscape one.
+ */
+static void
+bench_rotation(void)
+{
+    static uint8_t landscape_buf[SSD1306_FB_LEN(128, 64)];
+    static uint8_t portrait_buf[SSD1306_FB_LEN(64, 128)];
+    const long iterations = 20000;
+    struct ssd1306_fb landscape;
+    struct ssd1306_fb portrait;
+
+    printf("== rotation: full 128x64 frame ==\n");
+
+    check(ssd1306_fb_init(&landscape, landscape_buf, 128, 64),
+          "ssd1306_fb_init");
+    check(ssd1306_fb_init(&portrait, portrait_buf, 64, 128),
+          "ssd1306_fb_init");
+
+    for (size_t i = 0; i < sizeof(portrait_buf); i++) {
+        landscape_buf[i] = (uint8_t)(i * 7 + 3);
+        portrait_buf[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_mark_all_dirty(&landscape);
+        check(ssd1306_fb_flush(&ctx, &landscape), "ssd1306_fb_flush");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("0 deg     %6.0f ns/frame %6lu data bytes\n",
+           1e9 * elapsed / iterations, stats.data / iterations);
+
+    check(ssd1306_set_rotation(&ctx, SSD1306_ROTATE_90),
+          "ssd1306_set_rotation");
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        ssd1306_fb_mark_all_dirty(&portrait);
+        check(ssd1306_fb_flush(&ctx, &portrait), "ssd1306_fb_flush");
+    }
+
+    elapsed = seconds_since(start);
+
+    printf("90 deg    %6.0f ns/frame %6lu data bytes\n",
+           1e9 * elapsed / iterations, stats.data / iterations);
+
+    check(ssd1306_set_rotation(&ctx, SSD1306_ROTATE_0),
+          "ssd1306_set_rotation");
+    start = clock();
+
+    for (long n = 0; n < iterations / 10; n++) {
+        for (int16_t y = 0; y < 128; y++) {
+            for (int16_t x = 0; x < 64; x++) {
+                ssd1306_fb_set_pixel(&landscape, y, x,
+                                     ssd1306_fb_get_pixel(&portrait, x, y)
+                                         ? SSD1306_COLOR_ON
+                                         : SSD1306_COLOR_OFF);
+            }
+        }
+
+        check(ssd1306_fb_flush(&ctx, &landscape), "ssd1306_fb_flush");
+    }
+
+    elapsed = seconds_since(start);
+
+    printf("by pixel  %6.0f ns/frame\n", 1e9 * elapsed / (iterations / 10));
+    printf("\n");
+}
+
+/**
+ * A line of text on a display rotated 0 degrees versus 90 degrees with a
+ * transposed font, and versus transposing each glyph as it's written.
+ */
+static void
+bench_portrait_text(void)
+{
+    static const uint8_t line[] = "12:34:56";
+    static uint8_t glyphs[128 * 8];
+    const size_t len = sizeof(line) - 1;
+    const long iterations = 200000;
+    struct ssd1306_font portrait;
+
+    printf("== portrait text: \"%s\" ==\n", line);
+
+    check(ssd1306_transpose_font(&ssd1306_font8x8_basic, glyphs,
+                                 sizeof(glyphs), &portrait),
+          "ssd1306_transpose_font");
+
+    reset_stats();
+
+    clock_t start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_set_col_range(&ctx, SSD1306_COL_0,
+                                    (enum ssd1306_col)(len * 8 - 1)),
+              "ssd1306_set_col_range");
+        check(ssd1306_set_page_range(&ctx, SSD1306_PAGE_0, SSD1306_PAGE_0),
+              "ssd1306_set_page_range");
+        check(ssd1306_write_str(&ctx, line), "ssd1306_write_str");
+    }
+
+    double elapsed = seconds_since(start);
+
+    printf("0 deg       %6.1f ns/line %4lu bytes %3lu transfers\n",
+           1e9 * elapsed / iterations, stats.data / iterations,
+           stats.transfers / iterations);
+
+    check(ssd1306_set_rotation(&ctx, SSD1306_ROTATE_90),
+          "ssd1306_set_rotation");
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        check(ssd1306_write_str_portrait(&ctx, &portrait, 0, 0, line),
+              "ssd1306_write_str_portrait");
+    }
+
+    elapsed = seconds_since(start);
+
+    printf("90 deg      %6.1f ns/line %4lu bytes %3lu transfers\n",
+           1e9 * elapsed / iterations, stats.data / iterations,
+           stats.transfers / iterations);
+
+    reset_stats();
+    start = clock();
+
+    for (long n = 0; n < iterations; n++) {
+        struct ssd1306_data_chunk chunk = {.len = 0};
+
+        check(ssd1306_set_col_range(&ctx, SSD1306_COL_0, SSD1306_COL_7),
+              "ssd1306_set_col_range");
+        check(ssd1306_set_page_range(&ctx, SSD1306_PAGE_0,
+                                     (enum ssd1306_page)(len - 1)),
+              "ssd1306_set_page_range");
+
+        for (size_t i = 0; i < len; i++) {
+            const uint8_t *glyph;
+            uint8_t block[8];
+
+            check(ssd1306_find_glyph(&ssd1306_font8x8_basic, line[i], &glyph),
+                  "ssd1306_find_glyph");
+            ssd1306_transpose_8x8(glyph, block);
+            check(ssd1306_chunk_push_list(&ctx, &chunk, block, sizeof(block)),
+                  "ssd1306_chunk_push_list");
+        }
+
+        check(ssd1306_chunk_flush(&ctx, &chunk), "ssd1306_chunk_flush");
+    }
+
+    elapsed = seconds_since(start);
+
+    printf("per glyph   %6.1f ns/line %4lu bytes %3lu transfers\n",
+           1e9 * elapsed / iterations, stats.data / iterations,
+           stats.transfers / iterations);
+    printf("\n");
+
+    check(ssd1306_set_rotation(&ctx, SSD1306_ROTATE_0),
+          "ssd1306_set_rotation");
+}
+
+int
+main(void)
+{
+    bench_rle();
+    bench_scaled_text();
+    bench_label_cache();
+    bench_num_field();
+    bench_printf();
+    bench_fb_text();
+    bench_blit();
+    bench_draw();
+    bench_transpose();
+    bench_canvas();
+    bench_image();
+    bench_downscale();
+    bench_gray();
+    bench_flip();
+    bench_console();
+    bench_vt();
+    bench_marquee();
+    bench_chart();
+    bench_vscroll();
+    bench_viewport();
+    bench_transition();
+    bench_rotation();
+    bench_portrait_text();
+
+    return EXIT_SUCCESS;
+}
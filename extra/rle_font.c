@@ -0,0 +1,111 @@
+/**
+ * Run-length encode `ssd1306_font8x8_basic` into constant arrays.
+ *
+ * `ssd1306_rle_encode_font` fills out a font in RAM, which doesn't save any
+ * flash. This encodes the font at build time instead and prints a translation
+ * unit that holds the result as `const` arrays to stdout. `./src/rle_font.c` is
+ * its output for the default number of glyphs per block.
+ *
+ * Usage: `rle_font [glyphs_per_block]`
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/rle.h"
+
+/**
+ * Default number of glyphs per block. See `./extra/bench.c` for what the other
+ * sizes cost.
+ */
+#define DEFAULT_GLYPHS_PER_BLOCK 8
+
+/**
+ * Number of values printed per line.
+ */
+#define VALS_PER_LINE 12
+
+int
+main(int argc, char **argv)
+{
+    const struct ssd1306_font *font = &ssd1306_font8x8_basic;
+    static uint8_t data[4096];
+    static uint16_t offsets[SSD1306_RLE_NUM_BLOCK_OFFSETS(256, 1)];
+    struct ssd1306_rle_font rle_font;
+    long glyphs_per_block = DEFAULT_GLYPHS_PER_BLOCK;
+
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [glyphs_per_block]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    else if (argc == 2) {
+        glyphs_per_block = strtol(argv[1], NULL, 10);
+    }
+
+    if (glyphs_per_block < 1 || glyphs_per_block > UINT8_MAX) {
+        fprintf(stderr, "glyphs_per_block must be within [1, %d]\n",
+                UINT8_MAX);
+        return EXIT_FAILURE;
+    }
+
+    enum ssd1306_err err = ssd1306_rle_encode_font(
+        font, (uint8_t)glyphs_per_block, data, sizeof(data), offsets,
+        &rle_font);
+
+    if (err == SSD1306_RLE_NOT_SMALLER) {
+        fprintf(stderr, "%ld glyphs per block don't save any flash\n",
+                glyphs_per_block);
+        return EXIT_FAILURE;
+    }
+    else if (err != SSD1306_OK) {
+        fprintf(stderr, "ssd1306_rle_encode_font failed with %d\n", err);
+        return EXIT_FAILURE;
+    }
+
+    size_t num_offsets = SSD1306_RLE_NUM_BLOCK_OFFSETS(
+        rle_font.num_glyphs, rle_font.glyphs_per_block);
+    size_t data_len = offsets[num_offsets - 1];
+
+    printf("/*\n"
+           " * Generated by ./extra/rle_font.c from ssd1306_font8x8_basic, %u "
+           "glyphs\n"
+           " * per block. Don't edit.\n"
+           " */\n\n"
+           "#include \"ssd1306/rle.h\"\n\n"
+           "#include <stdint.h>\n\n",
+           (unsigned)rle_font.glyphs_per_block);
+
+    printf("static const uint8_t data[%zu] = {", data_len);
+
+    for (size_t i = 0; i < data_len; i++) {
+        printf("%s0x%02X,", i % VALS_PER_LINE == 0 ? "\n    " : " ", data[i]);
+    }
+
+    printf("\n};\n\n");
+    printf("static const uint16_t block_offsets[%zu] = {", num_offsets);
+
+    for (size_t i = 0; i < num_offsets; i++) {
+        printf("%s%u,", i % VALS_PER_LINE == 0 ? "\n    " : " ",
+               (unsigned)offsets[i]);
+    }
+
+    printf("\n};\n\n");
+    printf("const struct ssd1306_rle_font ssd1306_rle_font8x8_basic = {\n"
+           "    .data = data,\n"
+           "    .block_offsets = block_offsets,\n"
+           "    .num_glyphs = %u,\n"
+           "    .width = %u,\n"
+           "    .pages = %u,\n"
+           "    .first_char = 0x%02X,\n"
+           "    .glyphs_per_block = %u,\n"
+           "};\n",
+           (unsigned)rle_font.num_glyphs, (unsigned)rle_font.width,
+           (unsigned)rle_font.pages, (unsigned)rle_font.first_char,
+           (unsigned)rle_font.glyphs_per_block);
+
+    return EXIT_SUCCESS;
+}
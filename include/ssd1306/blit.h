@@ -0,0 +1,108 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_BLIT_H
+#define LIBSSD1306_SSD1306_BLIT_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup blit Blitter
+ *
+ * Combines a 1bpp bitmap with a rectangle of a framebuffer using a raster
+ * operation. Bitmaps share the layout of the display's RAM (page-major), so
+ * the blitter works on whole bytes, four columns at a time, instead of on
+ * pixels.
+ *
+ * A sprite with a transparent background is drawn with two blits: its mask
+ * with @ref SSD1306_ROP_CLEAR followed by the sprite with
+ * @ref SSD1306_ROP_SET. An inverted menu highlight is a blit of a solid bitmap
+ * with @ref SSD1306_ROP_XOR.
+ */
+
+/** @{ */
+
+/**
+ * Calculates the number of bytes a bitmap of the given dimensions needs.
+ *
+ * @param width  width of the bitmap, in columns
+ * @param height height of the bitmap, in rows
+ */
+#define SSD1306_BITMAP_LEN(width, height)                                      \
+    ((size_t)(width)                                                           \
+     * (((height) + SSD1306_ROWS_PER_PAGE - 1) / SSD1306_ROWS_PER_PAGE))
+
+/**
+ * A 1bpp bitmap in the layout of the display's RAM: byte
+ * @c data[page * width + x] holds rows @c page * 8 to @c page * 8 + 7 of
+ * column @c x, least significant bit on top. When @c height isn't a multiple
+ * of 8, the extra bits of the last page are ignored.
+ */
+struct ssd1306_bitmap {
+    /**
+     * Pixels, @ref SSD1306_BITMAP_LEN bytes.
+     */
+    const uint8_t *data;
+    /**
+     * Width, in columns.
+     */
+    uint16_t width;
+    /**
+     * Height, in rows.
+     */
+    uint16_t height;
+};
+
+/**
+ * How a bitmap's pixels (@c src) are combined with the framebuffer's
+ * (@c dst).
+ */
+enum ssd1306_rop {
+    SSD1306_ROP_COPY,     /**< <tt>dst = src</tt> */
+    SSD1306_ROP_SET,      /**< <tt>dst = dst | src</tt> */
+    SSD1306_ROP_CLEAR,    /**< <tt>dst = dst & ~src</tt> (and-not) */
+    SSD1306_ROP_XOR,      /**< <tt>dst = dst ^ src</tt> */
+    SSD1306_ROP_AND,      /**< <tt>dst = dst & src</tt> */
+    SSD1306_ROP_COPY_NOT, /**< <tt>dst = ~src</tt> */
+};
+
+/**
+ * Combines the top left @c w by @c h pixels of a bitmap with the framebuffer,
+ * the bitmap's top left corner landing on (@c x, @c y).
+ *
+ * The rectangle is clipped to the bitmap and to the framebuffer, and the part
+ * of it that's left is marked dirty. Copies to a row that's a multiple of 8
+ * are done with @c memcpy.
+ *
+ * @param fb     framebuffer to draw in
+ * @param bitmap bitmap to draw
+ * @param x      left most column to draw at
+ * @param y      top most row to draw at
+ * @param w      number of columns of the bitmap to draw
+ * @param h      number of rows of the bitmap to draw
+ * @param rop    how the bitmap is combined with the framebuffer
+ *
+ * @return @ref SSD1306_DATA_LIST_NULL if @c bitmap or its data is @c NULL
+ */
+enum ssd1306_err ssd1306_fb_blit(struct ssd1306_fb *fb,
+                                 const struct ssd1306_bitmap *bitmap,
+                                 int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                 enum ssd1306_rop rop);
+
+/** @} */ /* blit */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_BLIT_H */
@@ -0,0 +1,93 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_BUS_H
+#define LIBSSD1306_SSD1306_BUS_H
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup bus Bus Timing
+ *
+ * A model of how long the bus takes to deliver commands and data. Flushes use
+ * it to weigh opening another window against sending a few clean bytes and to
+ * stay within a time budget.
+ *
+ * The model charges a fixed cost for every call into the platform callbacks
+ * (@ref ssd1306_send_cmd sends one command byte per call,
+ * @ref ssd1306_write_data_list sends a whole list per call) plus a cost per
+ * byte on the wire.
+ */
+
+/** @{ */
+
+/**
+ * Time the bus takes to deliver commands and data.
+ */
+struct ssd1306_bus_model {
+    /**
+     * Nanoseconds to clock one byte out.
+     */
+    uint32_t byte_ns;
+    /**
+     * Nanoseconds of overhead per transaction: addressing and start/stop
+     * conditions on I2C, toggling @c CS and @c D/C on SPI. Adjust it with a
+     * measurement of the platform's callbacks for a tighter model.
+     */
+    uint32_t transaction_ns;
+};
+
+/**
+ * Models an I2C bus. Every byte takes 9 clocks (8 bits and the ACK) and every
+ * transaction sends a start condition, the address, the control byte and a
+ * stop condition, about 20 clocks.
+ *
+ * @param bus      model to initialize
+ * @param clock_hz SCL frequency, 100 kHz or 400 kHz for the SSD1306
+ */
+void ssd1306_bus_model_i2c(struct ssd1306_bus_model *bus, uint32_t clock_hz);
+
+/**
+ * Models a 4-wire SPI bus. Every byte takes 8 clocks and transactions have no
+ * overhead until @ref ssd1306_bus_model::transaction_ns is set.
+ *
+ * @param bus      model to initialize
+ * @param clock_hz SCLK frequency, up to 10 MHz for the SSD1306
+ */
+void ssd1306_bus_model_spi(struct ssd1306_bus_model *bus, uint32_t clock_hz);
+
+/**
+ * Estimates how long sending @c len command bytes takes, one
+ * @ref ssd1306_send_cmd call per byte.
+ *
+ * @param bus bus model
+ * @param len number of command bytes
+ *
+ * @return the time, in nanoseconds, saturated to @c UINT32_MAX
+ */
+uint32_t ssd1306_bus_cmd_ns(const struct ssd1306_bus_model *bus, size_t len);
+
+/**
+ * Estimates how long a single @ref ssd1306_write_data_list call of @c len
+ * bytes takes.
+ *
+ * @param bus bus model
+ * @param len number of data bytes
+ *
+ * @return the time, in nanoseconds, saturated to @c UINT32_MAX
+ */
+uint32_t ssd1306_bus_data_ns(const struct ssd1306_bus_model *bus, size_t len);
+
+/** @} */ /* bus */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_BUS_H */
@@ -0,0 +1,195 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_CANVAS_H
+#define LIBSSD1306_SSD1306_CANVAS_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup canvas Row-major Canvas
+ *
+ * A framebuffer in row-major layout, for drawing code that's simpler or
+ * faster when a byte holds 8 pixels of a row: ported algorithms, image
+ * filters, scanline fills, ...
+ *
+ * Row @c y starts at @c buf[y * stride] and bit @c x % 8 of byte
+ * @c buf[y * stride + x / 8] is pixel @c x (least significant bit on the
+ * left, like XBM). The display's RAM is page-major, so
+ * @ref ssd1306_canvas_flush transposes the dirty part of each 8 row band
+ * right before sending it. Nothing is converted while drawing.
+ *
+ * On a display rotated a quarter turn (see @ref ssd1306_set_rotation), the
+ * canvas's rows run along the display's columns and each of its bytes
+ * already is a byte of the display's RAM, so the flush sends them without
+ * transposing anything.
+ *
+ * Dirty tracking works like the @ref framebuffer's: one span of columns per
+ * band of 8 rows.
+ */
+
+/** @{ */
+
+/**
+ * Calculates the number of bytes a row of a canvas needs.
+ *
+ * @param width width of the canvas, in pixels
+ */
+#define SSD1306_CANVAS_STRIDE(width) (((size_t)(width) + 7) / 8)
+
+/**
+ * Calculates the number of bytes a canvas of the given dimensions needs.
+ *
+ * @param width  width of the canvas, in pixels
+ * @param height height of the canvas, in pixels
+ */
+#define SSD1306_CANVAS_LEN(width, height)                                      \
+    (SSD1306_CANVAS_STRIDE(width) * (size_t)(height))
+
+/**
+ * A row-major canvas. Initialize it with @ref ssd1306_canvas_init.
+ */
+struct ssd1306_canvas {
+    /**
+     * Pixels, @ref SSD1306_CANVAS_LEN bytes.
+     */
+    uint8_t *buf;
+    /**
+     * Bytes from one row to the next.
+     */
+    size_t stride;
+    /**
+     * Width, in pixels.
+     */
+    uint16_t width;
+    /**
+     * Height, in pixels. Always a multiple of @ref SSD1306_ROWS_PER_PAGE.
+     */
+    uint16_t height;
+
+    /**
+     * First dirty column of each band of 8 rows. A band is clean when its
+     * first dirty column is greater than its last.
+     */
+    uint8_t dirty_first[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+    /**
+     * Last dirty column of each band of 8 rows.
+     */
+    uint8_t dirty_last[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+};
+
+/**
+ * Sets up a canvas on top of @c buf and clears it.
+ *
+ * @param canvas canvas to initialize
+ * @param buf    storage for the pixels, @ref SSD1306_CANVAS_LEN bytes
+ * @param width  width of the canvas, in pixels
+ * @param height height of the canvas, in pixels (multiple of 8)
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the dimensions are zero, too big
+ *         for the display's RAM or @c height isn't a multiple of 8
+ */
+enum ssd1306_err ssd1306_canvas_init(struct ssd1306_canvas *canvas,
+                                     uint8_t *buf, uint16_t width,
+                                     uint16_t height);
+
+/**
+ * Turns every pixel off and marks the whole canvas dirty.
+ *
+ * @param canvas canvas to clear
+ */
+void ssd1306_canvas_clear(struct ssd1306_canvas *canvas);
+
+/**
+ * Marks a rectangle dirty. The rectangle is clipped to the canvas.
+ *
+ * Call it after changing @ref ssd1306_canvas::buf directly.
+ *
+ * @param canvas canvas to mark
+ * @param x      left most column
+ * @param y      top most row
+ * @param w      width, in columns
+ * @param h      height, in rows
+ */
+void ssd1306_canvas_mark_dirty(struct ssd1306_canvas *canvas, int16_t x,
+                               int16_t y, int16_t w, int16_t h);
+
+/**
+ * Marks the whole canvas dirty.
+ *
+ * @param canvas canvas to mark
+ */
+void ssd1306_canvas_mark_all_dirty(struct ssd1306_canvas *canvas);
+
+/**
+ * Marks the whole canvas clean.
+ *
+ * @param canvas canvas to mark
+ */
+void ssd1306_canvas_mark_clean(struct ssd1306_canvas *canvas);
+
+/**
+ * Draws a pixel. Pixels outside of the canvas are ignored.
+ *
+ * @param canvas canvas to draw in
+ * @param x      column of the pixel
+ * @param y      row of the pixel
+ * @param color  how to draw the pixel
+ */
+void ssd1306_canvas_set_pixel(struct ssd1306_canvas *canvas, int16_t x,
+                              int16_t y, enum ssd1306_color color);
+
+/**
+ * Reads a pixel.
+ *
+ * @param canvas canvas to read from
+ * @param x      column of the pixel
+ * @param y      row of the pixel
+ *
+ * @return @c true if the pixel is on, @c false if it's off or outside of the
+ *         canvas
+ */
+bool ssd1306_canvas_get_pixel(const struct ssd1306_canvas *canvas, int16_t x,
+                              int16_t y);
+
+/**
+ * Converts the dirty parts of the canvas to page-major, sends them to the
+ * display and marks the canvas clean.
+ *
+ * Only the 8x8 blocks that hold dirty columns are transposed. Consecutive
+ * bands share a window whenever sending the extra clean columns costs less
+ * than opening another window. This function changes the column and page
+ * ranges and assumes @ref SSD1306_HORIZ_ADDR_MODE.
+ *
+ * When @ref ssd1306_is_portrait, band @c b is the display's columns @c b * 8
+ * to @c b * 8 + 7 and the bytes of its rows are sent as they are, windows
+ * spanning the display's pages that hold dirty columns.
+ *
+ * @param ctx    struct that contains the platform dependent I/O
+ * @param canvas canvas to flush
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the canvas is bigger than the
+ *         display, as rotated, or is portrait and its width isn't a multiple
+ *         of 8
+ */
+enum ssd1306_err ssd1306_canvas_flush(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_canvas *canvas);
+
+/** @} */ /* canvas */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_CANVAS_H */
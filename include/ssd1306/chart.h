@@ -0,0 +1,156 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_CHART_H
+#define LIBSSD1306_SSD1306_CHART_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup chart Strip Chart
+ *
+ * A rolling graph of samples, one column per sample, that never resends the
+ * columns already on screen. Each sample is drawn as a vertical span from the
+ * previous one, and only the pages that span or the trace it replaces touch
+ * are written.
+ *
+ * - @ref SSD1306_CHART_SWEEP draws like an oscilloscope: a cursor sweeps left
+ *   to right and each sample overwrites the oldest column in place.
+ * - @ref SSD1306_CHART_SCROLL scrolls the chart's pages left in hardware, one
+ *   column every scroll step, and writes the latest sample into the columns
+ *   that wrapped around to the right edge. The time axis follows the scroll,
+ *   not the samples. Several columns are written in vertical addressing mode,
+ *   so they go out as one window, column after column.
+ */
+
+/** @{ */
+
+/**
+ * How a chart moves.
+ */
+enum ssd1306_chart_mode {
+    SSD1306_CHART_SWEEP,  /**< A cursor sweeps over a still chart. */
+    SSD1306_CHART_SCROLL, /**< The chart scrolls left in hardware. */
+};
+
+/**
+ * A strip chart. Initialize it with @ref ssd1306_chart_init.
+ */
+struct ssd1306_chart {
+    /**
+     * A @ref ssd1306_chart_mode.
+     */
+    uint8_t mode;
+    /**
+     * First page of the chart.
+     */
+    uint8_t first_page;
+    /**
+     * Pages in the chart.
+     */
+    uint8_t pages;
+    /**
+     * Columns in the chart, the display's width.
+     */
+    uint8_t width;
+    /**
+     * Column the next sample goes in. In @ref SSD1306_CHART_SCROLL mode, the
+     * column that wraps around next.
+     */
+    uint8_t cursor;
+    /**
+     * Row of the last sample drawn, from the top of the chart.
+     */
+    uint8_t last_row;
+    /**
+     * Row of the latest sample, drawn at the next scroll step.
+     */
+    uint8_t row;
+    /**
+     * First row of the trace in each column, by column of the chart's ring.
+     * A column is blank when it's after @c trace_last.
+     */
+    uint8_t trace_first[SSD1306_FB_MAX_WIDTH];
+    /**
+     * Last row of the trace in each column.
+     */
+    uint8_t trace_last[SSD1306_FB_MAX_WIDTH];
+    /**
+     * Value of @ref ssd1306_scroll_steps the columns were last drawn up to.
+     */
+    uint32_t steps_drawn;
+};
+
+/**
+ * Clears the chart's pages and, in @ref SSD1306_CHART_SCROLL mode, starts
+ * scrolling them.
+ *
+ * @param ctx        struct that contains the platform dependent I/O
+ * @param chart      chart to initialize
+ * @param mode       how the chart moves
+ * @param first_page first page of the chart
+ * @param pages      pages in the chart
+ * @param clock      clock locked to the display, only used when scrolling.
+ *                   It must outlive the scroll.
+ * @param interval   frames between scroll steps, only used when scrolling
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the chart doesn't fit on the
+ *         display
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, which would run the samples down the screen
+ */
+enum ssd1306_err ssd1306_chart_init(struct ssd1306_ctx *ctx,
+                                    struct ssd1306_chart *chart,
+                                    enum ssd1306_chart_mode mode,
+                                    uint8_t first_page, uint8_t pages,
+                                    const struct ssd1306_frame_clock *clock,
+                                    enum ssd1306_scroll_step interval);
+
+/**
+ * Adds a sample. When sweeping it's drawn right away, when scrolling it's
+ * drawn in the columns the scroll wraps around from now on.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param chart chart to add to
+ * @param value sample, in rows above the bottom of the chart. Values above
+ *              the top are clamped.
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn. The sample is dropped.
+ */
+enum ssd1306_err ssd1306_chart_push(struct ssd1306_ctx *ctx,
+                                    struct ssd1306_chart *chart,
+                                    uint8_t value);
+
+/**
+ * Draws the latest sample in the columns that wrapped around since the last
+ * tick, in @ref SSD1306_CHART_SCROLL mode. Sends nothing if the scroll hasn't
+ * taken a step or the chart sweeps. @ref ssd1306_chart_push ticks too.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param chart chart to update
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_chart_tick(struct ssd1306_ctx *ctx,
+                                    struct ssd1306_chart *chart);
+
+/** @} */ /* chart */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_CHART_H */
@@ -0,0 +1,176 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_CONSOLE_H
+#define LIBSSD1306_SSD1306_CONSOLE_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup console Console
+ *
+ * A text console that scrolls in hardware. The display's 64 rows of RAM are
+ * used as a ring of text lines and the start line register points at the
+ * line shown at the top. Scrolling by a line clears the line that scrolls in
+ * and moves the start line: a page of data and a command byte, instead of
+ * resending the whole display.
+ *
+ * Text is written with @ref ssd1306_ctx::font, whose height must divide the
+ * 8 pages of the display's RAM. The console also remembers where the display's
+ * RAM pointer was left, so consecutive characters are streamed without any
+ * addressing commands.
+ *
+ * The console owns the display's RAM and start line. Drawing through anything
+ * else while it's in use garbles it.
+ */
+
+/** @{ */
+
+/**
+ * Value of @ref ssd1306_console::ram_page when the display's RAM pointer
+ * isn't known.
+ */
+#define SSD1306_CONSOLE_RAM_UNKNOWN 0xFF
+
+/**
+ * A console. Initialize it with @ref ssd1306_console_init.
+ */
+struct ssd1306_console {
+    /**
+     * Font the text is drawn with.
+     */
+    const struct ssd1306_font *font;
+    /**
+     * Characters per line.
+     */
+    uint8_t cols;
+    /**
+     * Lines on screen.
+     */
+    uint8_t rows;
+    /**
+     * Lines in the display's RAM, the length of the ring.
+     */
+    uint8_t ring_lines;
+    /**
+     * Line of the ring shown at the top of the screen.
+     */
+    uint8_t top;
+    /**
+     * Column the next character goes in.
+     */
+    uint8_t cursor_col;
+    /**
+     * Line on screen, from the top, the next character goes in.
+     */
+    uint8_t cursor_row;
+    /**
+     * Page of the display's RAM the next data byte lands in, or
+     * @ref SSD1306_CONSOLE_RAM_UNKNOWN.
+     */
+    uint8_t ram_page;
+    /**
+     * Column of the display's RAM the next data byte lands in.
+     */
+    uint8_t ram_col;
+};
+
+/**
+ * Clears the display's RAM, shows the first line of the ring at the top and
+ * puts the cursor in the top left corner.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param console console to initialize
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the font's height doesn't divide
+ *         the display's RAM or no character fits on the screen
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn. Lines are pages of the RAM as wired.
+ */
+enum ssd1306_err ssd1306_console_init(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_console *console);
+
+/**
+ * Finds the page of the display's RAM a line on screen starts at.
+ *
+ * @param console console the line belongs to
+ * @param row     line on screen, from the top
+ *
+ * @return the page
+ */
+uint8_t ssd1306_console_page(const struct ssd1306_console *console,
+                             uint8_t row);
+
+/**
+ * Scrolls the text up by a line. The line that scrolls in at the bottom is
+ * blank. The cursor stays where it is on screen.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param console console to scroll
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_console_scroll(struct ssd1306_ctx *ctx,
+                                        struct ssd1306_console *console);
+
+/**
+ * Writes characters at a position on screen, without moving the cursor or
+ * wrapping. Characters past the end of the line are dropped.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param console console to write to
+ * @param row     line on screen
+ * @param col     column of the first character
+ * @param chars   characters to write
+ * @param len     number of characters
+ * @param invert  whether to draw the characters inverted
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font has no glyph for one of
+ *         the characters
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_console_draw(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_console *console,
+                                      uint8_t row, uint8_t col,
+                                      const uint8_t *chars, size_t len,
+                                      bool invert);
+
+/**
+ * Writes text at the cursor. A @c '\\n' moves the cursor to the start of the
+ * next line and a @c '\\r' to the start of the current one. Lines that run
+ * past the right edge wrap, and moving past the last line scrolls.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param console console to write to
+ * @param data    text to write
+ * @param len     length of @c data
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font has no glyph for one of
+ *         the characters
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_console_write(struct ssd1306_ctx *ctx,
+                                       struct ssd1306_console *console,
+                                       const uint8_t *data, size_t len);
+
+/** @} */ /* console */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_CONSOLE_H */
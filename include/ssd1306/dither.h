@@ -0,0 +1,142 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_DITHER_H
+#define LIBSSD1306_SSD1306_DITHER_H
+
+#include "ssd1306/canvas.h"
+#include "ssd1306/err.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup dither Dithering
+ *
+ * Turns 8 bit grayscale rows into a 1bpp page-major bitmap.
+ *
+ * Rows are pushed one at a time, top to bottom, into a
+ * @ref ssd1306_ditherer. Every 8 rows make a page, which is transposed
+ * straight into the output bitmap (see @ref transpose), so no more than 8
+ * rows of 1bpp pixels are ever buffered.
+ *
+ * | Mode                                | Cost per pixel                 |
+ * | ----------------------------------- | ------------------------------ |
+ * | @ref SSD1306_DITHER_THRESHOLD       | 1 compare, 16 at once w/ SIMD  |
+ * | @ref SSD1306_DITHER_ORDERED         | 1 compare, 16 at once w/ SIMD  |
+ * | @ref SSD1306_DITHER_FLOYD_STEINBERG | a handful of adds and shifts   |
+ */
+
+/** @{ */
+
+/**
+ * Widest image, in pixels, that can be dithered or imported. It sizes the
+ * buffers of @ref ssd1306_ditherer.
+ */
+#ifndef SSD1306_IMAGE_MAX_WIDTH
+#define SSD1306_IMAGE_MAX_WIDTH 128
+#endif
+
+/**
+ * How gray levels are turned into pixels that are either on or off.
+ */
+enum ssd1306_dither {
+    /** A pixel is on when its level is 128 or more. */
+    SSD1306_DITHER_THRESHOLD,
+    /** Each pixel is compared against its entry of an 8x8 Bayer matrix. */
+    SSD1306_DITHER_ORDERED,
+    /**
+     * Floyd-Steinberg error diffusion, with the error of the next row kept in
+     * a single line buffer.
+     */
+    SSD1306_DITHER_FLOYD_STEINBERG,
+};
+
+/**
+ * State of an image being dithered. Set it up with
+ * @ref ssd1306_ditherer_init.
+ */
+struct ssd1306_ditherer {
+    /**
+     * How gray levels are turned into pixels.
+     */
+    enum ssd1306_dither mode;
+    /**
+     * Width of the rows, in pixels.
+     */
+    uint16_t width;
+    /**
+     * Row the next pushed row lands on.
+     */
+    uint16_t row;
+    /**
+     * Page-major output, see @ref ssd1306_bitmap.
+     */
+    uint8_t *dst;
+    /**
+     * Pixels of the current page, row-major with the least significant bit on
+     * the left.
+     */
+    uint8_t rows[SSD1306_ROWS_PER_PAGE]
+                [SSD1306_CANVAS_STRIDE(SSD1306_IMAGE_MAX_WIDTH)];
+    /**
+     * Error diffused into the next row by
+     * @ref SSD1306_DITHER_FLOYD_STEINBERG.
+     */
+    int16_t err[SSD1306_IMAGE_MAX_WIDTH];
+};
+
+/**
+ * Sets up a ditherer.
+ *
+ * An image can be dithered in horizontal bands, each with its own ditherer,
+ * by starting each band at a different @c first_row. Ordered and threshold
+ * dithering give the same result either way. Floyd-Steinberg diffuses error
+ * from one row to the next, so its bands show seams.
+ *
+ * @param ditherer  ditherer to set up
+ * @param mode      how gray levels are turned into pixels
+ * @param width     width of the rows, in pixels
+ * @param first_row row of the image the first pushed row is, a multiple of 8
+ * @param dst       page-major output for the whole image, the rows of
+ *                  @c first_row onwards are written
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if @c width is 0 or bigger than
+ *         @ref SSD1306_IMAGE_MAX_WIDTH or @c first_row isn't a multiple of 8
+ */
+enum ssd1306_err ssd1306_ditherer_init(struct ssd1306_ditherer *ditherer,
+                                       enum ssd1306_dither mode,
+                                       uint16_t width, uint16_t first_row,
+                                       uint8_t *dst);
+
+/**
+ * Dithers a row of gray levels. The page the row belongs to is written to the
+ * output once its 8th row is pushed.
+ *
+ * @param ditherer ditherer to push to
+ * @param gray     @c width gray levels, 0 is black and 255 white
+ */
+void ssd1306_ditherer_push_row(struct ssd1306_ditherer *ditherer,
+                               const uint8_t *gray);
+
+/**
+ * Writes the last page to the output when the number of rows pushed isn't a
+ * multiple of 8. The rows missing from the page are off.
+ *
+ * @param ditherer ditherer to finish
+ */
+void ssd1306_ditherer_finish(struct ssd1306_ditherer *ditherer);
+
+/** @} */ /* dither */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_DITHER_H */
@@ -0,0 +1,160 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_DRAW_H
+#define LIBSSD1306_SSD1306_DRAW_H
+
+#include "ssd1306/fb.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup draw Drawing
+ *
+ * Lines, rectangles, circles and rounded boxes drawn into a framebuffer.
+ *
+ * Every shape is broken down into spans that suit the framebuffer's page-major
+ * layout. A horizontal span is the same bit of consecutive bytes in one page.
+ * A vertical span is whole bytes in the pages it covers plus at most two
+ * partially covered bytes at its ends. No shape is drawn a pixel at a time,
+ * and every span marks only its own pixels dirty.
+ *
+ * Shapes are clipped to the framebuffer. No pixel is drawn twice, so shapes
+ * drawn with @ref SSD1306_COLOR_INVERT flip each of their pixels exactly once.
+ */
+
+/** @{ */
+
+/**
+ * Draws a horizontal line.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     left most column
+ * @param y     row of the line
+ * @param w     length, in columns
+ * @param color how to draw the line
+ */
+void ssd1306_fb_hline(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t w,
+                      enum ssd1306_color color);
+
+/**
+ * Draws a vertical line.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     column of the line
+ * @param y     top most row
+ * @param h     length, in rows
+ * @param color how to draw the line
+ */
+void ssd1306_fb_vline(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t h,
+                      enum ssd1306_color color);
+
+/**
+ * Draws a line between two pixels, both included.
+ *
+ * The line is walked with Bresenham's algorithm and drawn as one span per run
+ * of pixels on the same row (or column, for lines steeper than 45 degrees).
+ *
+ * @param fb    framebuffer to draw in
+ * @param x0    column of the first end
+ * @param y0    row of the first end
+ * @param x1    column of the second end
+ * @param y1    row of the second end
+ * @param color how to draw the line
+ */
+void ssd1306_fb_line(struct ssd1306_fb *fb, int16_t x0, int16_t y0, int16_t x1,
+                     int16_t y1, enum ssd1306_color color);
+
+/**
+ * Draws the outline of a rectangle.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     left most column
+ * @param y     top most row
+ * @param w     width, in columns
+ * @param h     height, in rows
+ * @param color how to draw the outline
+ */
+void ssd1306_fb_rect(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t w,
+                     uint16_t h, enum ssd1306_color color);
+
+/**
+ * Draws a filled rectangle.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     left most column
+ * @param y     top most row
+ * @param w     width, in columns
+ * @param h     height, in rows
+ * @param color how to draw the rectangle
+ */
+void ssd1306_fb_fill_rect(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                          uint16_t w, uint16_t h, enum ssd1306_color color);
+
+/**
+ * Draws the outline of a circle with the midpoint circle algorithm.
+ *
+ * @param fb    framebuffer to draw in
+ * @param cx    column of the center
+ * @param cy    row of the center
+ * @param r     radius, in pixels
+ * @param color how to draw the outline
+ */
+void ssd1306_fb_circle(struct ssd1306_fb *fb, int16_t cx, int16_t cy,
+                       uint16_t r, enum ssd1306_color color);
+
+/**
+ * Draws a filled circle. It covers exactly the pixels on and inside of the
+ * outline drawn by @ref ssd1306_fb_circle.
+ *
+ * @param fb    framebuffer to draw in
+ * @param cx    column of the center
+ * @param cy    row of the center
+ * @param r     radius, in pixels
+ * @param color how to draw the circle
+ */
+void ssd1306_fb_fill_circle(struct ssd1306_fb *fb, int16_t cx, int16_t cy,
+                            uint16_t r, enum ssd1306_color color);
+
+/**
+ * Draws the outline of a rectangle with rounded corners.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     left most column
+ * @param y     top most row
+ * @param w     width, in columns
+ * @param h     height, in rows
+ * @param r     radius of the corners, reduced to fit the rectangle if needed
+ * @param color how to draw the outline
+ */
+void ssd1306_fb_round_rect(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                           uint16_t w, uint16_t h, uint16_t r,
+                           enum ssd1306_color color);
+
+/**
+ * Draws a filled rectangle with rounded corners.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     left most column
+ * @param y     top most row
+ * @param w     width, in columns
+ * @param h     height, in rows
+ * @param r     radius of the corners, reduced to fit the rectangle if needed
+ * @param color how to draw the rectangle
+ */
+void ssd1306_fb_fill_round_rect(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                                uint16_t w, uint16_t h, uint16_t r,
+                                enum ssd1306_color color);
+
+/** @} */ /* draw */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_DRAW_H */
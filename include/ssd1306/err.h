@@ -105,6 +105,65 @@ enum ssd1306_err {
      * @see ssd1306_scroll_vert_left
      */
     SSD1306_UPPER_BOUND_GT_LOWER_BOUND,
+
+    /**
+     * A compressed stream ended in the middle of an operation.
+     *
+     * @see ssd1306_rle_decode
+     */
+    SSD1306_RLE_TRUNCATED,
+    /**
+     * The buffer passed in can't hold the result of the operation.
+     */
+    SSD1306_BUFFER_TOO_SMALL,
+    /**
+     * The font doesn't contain a glyph for the requested character.
+     */
+    SSD1306_GLYPH_NOT_IN_FONT,
+    /**
+     * The area being written to doesn't fit within the dimensions of the OLED.
+     */
+    SSD1306_OUT_OF_DIMENSION,
+    /**
+     * The scale factor passed in isn't supported.
+     *
+     * @see ssd1306_write_str_scaled
+     */
+    SSD1306_SCALE_UNSUPPORTED,
+    /**
+     * The format string contains a conversion that isn't supported.
+     *
+     * @see ssd1306_printf
+     */
+    SSD1306_FORMAT_UNSUPPORTED,
+    /**
+     * The image is truncated, has a malformed header or is in a format that
+     * isn't supported.
+     *
+     * @see ssd1306_image_parse
+     */
+    SSD1306_IMAGE_MALFORMED,
+    /**
+     * The number of bits per pixel passed in isn't supported.
+     *
+     * @see ssd1306_gray_init
+     */
+    SSD1306_DEPTH_UNSUPPORTED,
+    /**
+     * Encoding the data, index included, took as much space as the data
+     * itself.
+     *
+     * @see ssd1306_rle_encode_font
+     */
+    SSD1306_RLE_NOT_SMALLER,
+    /**
+     * The display is rotated a quarter turn and the function lays its data
+     * out for the display's RAM as wired, or the other way around.
+     *
+     * @see ssd1306_set_rotation
+     * @see ssd1306_is_portrait
+     */
+    SSD1306_ROTATION_UNSUPPORTED,
 };
 
 /**
@@ -0,0 +1,268 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_FB_H
+#define LIBSSD1306_SSD1306_FB_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup framebuffer Framebuffer
+ *
+ * A copy of the display's RAM kept in the microcontroller's RAM. Drawing
+ * happens in the framebuffer and @ref ssd1306_fb_flush sends the parts that
+ * changed to the display.
+ *
+ * The framebuffer uses the same layout as the display's RAM (page-major):
+ * byte @c buf[page * width + x] holds rows @c page * 8 to @c page * 8 + 7 of
+ * column @c x, with the least significant bit being the top row.
+ *
+ * Every drawing function records the area it touched in a dirty tracker. The
+ * tracker keeps one span of columns per page, so a flush only sends the
+ * columns of the pages that actually changed.
+ */
+
+/** @{ */
+
+/**
+ * Most pages a framebuffer can have. It's the number of pages in the display's
+ * RAM.
+ */
+#define SSD1306_FB_MAX_PAGES 8
+
+/**
+ * Most columns a framebuffer can have. It's the number of columns in the
+ * display's RAM.
+ */
+#define SSD1306_FB_MAX_WIDTH 128
+
+/**
+ * Most rows a framebuffer can have. It's the number of columns in the
+ * display's RAM, which portrait framebuffers are as tall as (see
+ * @ref ssd1306_set_rotation).
+ */
+#define SSD1306_FB_MAX_HEIGHT SSD1306_FB_MAX_WIDTH
+
+/**
+ * Calculates the number of bytes a framebuffer of the given dimensions needs.
+ *
+ * @param width  width of the framebuffer, in columns
+ * @param height height of the framebuffer, in rows
+ */
+#define SSD1306_FB_LEN(width, height)                                          \
+    ((size_t)(width) * ((height) / SSD1306_ROWS_PER_PAGE))
+
+/**
+ * Number of command bytes it takes to open a window in the display's RAM
+ * (@ref ssd1306_set_col_range followed by @ref ssd1306_set_page_range).
+ * Flushing uses it to decide when sending a few clean bytes is cheaper than
+ * opening another window.
+ */
+#define SSD1306_WINDOW_CMD_LEN 6
+
+/**
+ * How a pixel is drawn.
+ */
+enum ssd1306_color {
+    SSD1306_COLOR_OFF,    /**< Turn the pixel off. */
+    SSD1306_COLOR_ON,     /**< Turn the pixel on. */
+    SSD1306_COLOR_INVERT, /**< Flip the pixel. */
+};
+
+/**
+ * A framebuffer. Initialize it with @ref ssd1306_fb_init.
+ */
+struct ssd1306_fb {
+    /**
+     * Pixels, @ref SSD1306_FB_LEN bytes.
+     */
+    uint8_t *buf;
+    /**
+     * Width, in columns.
+     */
+    uint16_t width;
+    /**
+     * Height, in rows. Always a multiple of @ref SSD1306_ROWS_PER_PAGE.
+     */
+    uint16_t height;
+
+    /**
+     * First dirty column of each page. A page is clean when its first dirty
+     * column is greater than its last.
+     */
+    uint8_t dirty_first[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+    /**
+     * Last dirty column of each page.
+     */
+    uint8_t dirty_last[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+};
+
+/**
+ * Sets up a framebuffer on top of @c buf and clears it.
+ *
+ * The framebuffer maps onto the display's RAM starting at column 0 and
+ * page 0. On a display rotated a quarter turn, its columns map onto the
+ * display's rows and its pages onto groups of 8 of the display's columns.
+ *
+ * @param fb     framebuffer to initialize
+ * @param buf    storage for the pixels, @ref SSD1306_FB_LEN bytes
+ * @param width  width of the framebuffer, in columns
+ * @param height height of the framebuffer, in rows (multiple of 8)
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the dimensions are zero, too big
+ *         for the display's RAM or @c height isn't a multiple of 8
+ */
+enum ssd1306_err ssd1306_fb_init(struct ssd1306_fb *fb, uint8_t *buf,
+                                 uint16_t width, uint16_t height);
+
+/**
+ * Turns every pixel off and marks the whole framebuffer dirty.
+ *
+ * @param fb framebuffer to clear
+ */
+void ssd1306_fb_clear(struct ssd1306_fb *fb);
+
+/**
+ * Marks a rectangle dirty. The rectangle is clipped to the framebuffer.
+ *
+ * Drawing functions do this on their own. Call it after changing
+ * @ref ssd1306_fb::buf directly.
+ *
+ * @param fb framebuffer to mark
+ * @param x  left most column
+ * @param y  top most row
+ * @param w  width, in columns
+ * @param h  height, in rows
+ */
+void ssd1306_fb_mark_dirty(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                           int16_t w, int16_t h);
+
+/**
+ * Marks the whole framebuffer dirty.
+ *
+ * @param fb framebuffer to mark
+ */
+void ssd1306_fb_mark_all_dirty(struct ssd1306_fb *fb);
+
+/**
+ * Marks the whole framebuffer clean.
+ *
+ * @param fb framebuffer to mark
+ */
+void ssd1306_fb_mark_clean(struct ssd1306_fb *fb);
+
+/**
+ * Checks whether a page has anything to flush.
+ *
+ * @param fb   framebuffer to check
+ * @param page page to check
+ */
+bool ssd1306_fb_is_page_dirty(const struct ssd1306_fb *fb, uint8_t page);
+
+/**
+ * Draws a pixel. Pixels outside of the framebuffer are ignored.
+ *
+ * @param fb    framebuffer to draw in
+ * @param x     column of the pixel
+ * @param y     row of the pixel
+ * @param color how to draw the pixel
+ */
+void ssd1306_fb_set_pixel(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                          enum ssd1306_color color);
+
+/**
+ * Reads a pixel.
+ *
+ * @param fb framebuffer to read from
+ * @param x  column of the pixel
+ * @param y  row of the pixel
+ *
+ * @return @c true if the pixel is on, @c false if it's off or outside of the
+ *         framebuffer
+ */
+bool ssd1306_fb_get_pixel(const struct ssd1306_fb *fb, int16_t x, int16_t y);
+
+/**
+ * Draws a character with its top left corner at any pixel.
+ *
+ * The glyph's cell is drawn opaque: the glyph's pixels are turned on and the
+ * rest of the cell is turned off (or the other way around when @c inverted).
+ * When @c y isn't a multiple of 8, each glyph column is shifted into the two
+ * pages it straddles and merged with masks, a byte at a time. The glyph is
+ * clipped to the framebuffer.
+ *
+ * @param fb       framebuffer to draw in
+ * @param font     font to draw the character with
+ * @param x        left most column of the glyph
+ * @param y        top most row of the glyph
+ * @param c        character to draw
+ * @param inverted draw the glyph's pixels off and the rest of its cell on
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if @c font has no glyph for @c c
+ */
+enum ssd1306_err ssd1306_fb_draw_char(struct ssd1306_fb *fb,
+                                      const struct ssd1306_font *font,
+                                      int16_t x, int16_t y, uint8_t c,
+                                      bool inverted);
+
+/**
+ * Draws a string with its top left corner at any pixel.
+ *
+ * @see ssd1306_fb_draw_char
+ *
+ * @param fb       framebuffer to draw in
+ * @param font     font to draw the string with
+ * @param x        left most column of the first glyph
+ * @param y        top most row of the glyphs
+ * @param str      string to draw
+ * @param inverted draw the glyphs' pixels off and the rest of their cells on
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if @c font is missing a glyph
+ */
+enum ssd1306_err ssd1306_fb_draw_str(struct ssd1306_fb *fb,
+                                     const struct ssd1306_font *font,
+                                     int16_t x, int16_t y, const uint8_t *str,
+                                     bool inverted);
+
+/**
+ * Sends the dirty parts of the framebuffer to the display and marks it clean.
+ *
+ * Dirty pages are sent in windows. Consecutive pages share a window whenever
+ * sending the extra clean columns costs less than opening another window.
+ * This function changes the column and page ranges and assumes
+ * @ref SSD1306_HORIZ_ADDR_MODE.
+ *
+ * When @ref ssd1306_is_portrait, each dirty 8x8 block is transposed on the
+ * way out and consecutive pages share a window, 8 of the display's columns
+ * each, while it's cheaper.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ * @param fb  framebuffer to flush
+ *
+ * @return @ref SSD1306_DATA_LIST_NULL if @c fb is @c NULL
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the framebuffer is bigger than the
+ *         display, as rotated, or is portrait and its width isn't a multiple
+ *         of 8
+ */
+enum ssd1306_err ssd1306_fb_flush(struct ssd1306_ctx *ctx,
+                                  struct ssd1306_fb *fb);
+
+/** @} */ /* framebuffer */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_FB_H */
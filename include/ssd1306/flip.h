@@ -0,0 +1,121 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_FLIP_H
+#define LIBSSD1306_SSD1306_FLIP_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/shadow.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup flip Page Flipping
+ *
+ * Double buffering for panels with at most 32 rows. The display's RAM always
+ * has 64 rows, and a 128x32 panel only shows 32 of them. The next frame is
+ * written to the hidden half while the visible one stays on screen, then a
+ * single @ref ssd1306_set_start_line command makes the hidden half visible.
+ * No partially written frame is ever shown and the swap costs one byte on
+ * the bus.
+ *
+ * Each half has a @ref ssd1306_shadow, so presenting a frame only sends what
+ * differs from the frame that was in the back half before: the one from two
+ * presents ago.
+ *
+ * Requires @ref ssd1306_init_display to have made only
+ * @ref ssd1306_ctx::height rows active.
+ */
+
+/** @{ */
+
+/**
+ * Calculates the number of bytes @ref ssd1306_flip_init needs for the
+ * shadows of both halves.
+ *
+ * @param width  width of the display, in columns
+ * @param height height of the display, in rows
+ */
+#define SSD1306_FLIP_LEN(width, height) (2 * SSD1306_FB_LEN(width, height))
+
+/**
+ * Page flipping state. Initialize it with @ref ssd1306_flip_init.
+ */
+struct ssd1306_flip {
+    /**
+     * Shadows of the two halves of the display's RAM. Half @c i starts at row
+     * @c i * @ref ssd1306_ctx::height.
+     */
+    struct ssd1306_shadow halves[2];
+    /**
+     * Half being shown.
+     */
+    uint8_t front;
+};
+
+/**
+ * Shows the first half of the display's RAM and sets up the shadows of both
+ * halves. Both start stale, so the first frame presented to each is sent
+ * whole.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param flip state to initialize
+ * @param buf  storage for the shadows, @ref SSD1306_FLIP_LEN bytes
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if two frames don't fit in the
+ *         display's RAM or the height isn't a multiple of 8
+ */
+enum ssd1306_err ssd1306_flip_init(struct ssd1306_ctx *ctx,
+                                   struct ssd1306_flip *flip, uint8_t *buf);
+
+/**
+ * Writes a frame to the hidden half, sending only what differs from what's
+ * already there.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param flip  page flipping state
+ * @param frame frame to write, laid out like a framebuffer of the display's
+ *              size (see @ref framebuffer)
+ *
+ * @return see @ref ssd1306_shadow_flush
+ */
+enum ssd1306_err ssd1306_flip_write(struct ssd1306_ctx *ctx,
+                                    struct ssd1306_flip *flip,
+                                    const uint8_t *frame);
+
+/**
+ * Shows the hidden half, which becomes the front one.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param flip page flipping state
+ */
+enum ssd1306_err ssd1306_flip_swap(struct ssd1306_ctx *ctx,
+                                   struct ssd1306_flip *flip);
+
+/**
+ * Writes a frame to the hidden half and shows it.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param flip  page flipping state
+ * @param frame frame to show
+ *
+ * @return see @ref ssd1306_flip_write
+ */
+enum ssd1306_err ssd1306_flip_present(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_flip *flip,
+                                      const uint8_t *frame);
+
+/** @} */ /* flip */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_FLIP_H */
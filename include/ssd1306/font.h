@@ -7,29 +7,244 @@
 
 #include "ssd1306/err.h"
 #include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
 
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
 #include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Describes a bitmap font in the format the @c SSD1306 expects data in.
+ *
+ * Every glyph is @c width columns wide and @c pages pages tall. A glyph's data
+ * is stored page by page: the @c width bytes of its first page, followed by the
+ * @c width bytes of its second page and so on. Within a byte, the least
+ * significant bit is the top row of the page.
+ */
+struct ssd1306_font {
+    /**
+     * Glyph data, @c width * @c pages bytes per glyph.
+     */
+    const uint8_t *glyphs;
+    /**
+     * Number of columns in a glyph.
+     */
+    uint8_t width;
+    /**
+     * Number of pages in a glyph.
+     */
+    uint8_t pages;
+    /**
+     * Character that the first glyph in @c glyphs encodes.
+     */
+    uint8_t first_char;
+    /**
+     * Number of glyphs in @c glyphs.
+     */
+    uint16_t num_glyphs;
+};
+
+/**
+ * The 8x8 font embedded in the library. It covers U+0000 - U+007F.
+ */
+extern const struct ssd1306_font ssd1306_font8x8_basic;
+
+/**
+ * Largest factor accepted by @ref ssd1306_write_str_scaled.
+ */
+#define SSD1306_MAX_TEXT_SCALE 4
+
+/**
+ * Returns the font the text rendering functions use for @c ctx.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ *
+ * @return @ref ssd1306_ctx::font or @ref ssd1306_font8x8_basic if it's @c NULL
+ */
+const struct ssd1306_font *ssd1306_get_font(const struct ssd1306_ctx *ctx);
+
+/**
+ * Looks up the glyph of a character.
+ *
+ * @param font  font to look the glyph up in
+ * @param c     character to look up
+ * @param glyph set to the glyph's data
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if @c font has no glyph for @c c
+ */
+enum ssd1306_err ssd1306_find_glyph(const struct ssd1306_font *font, uint8_t c,
+                                    const uint8_t **glyph);
+
 /**
  * Writes a string to the display.
  *
  * @param ctx struct that contains the platform dependent I/O
  * @param str string to write to the display
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, which glyphs aren't laid out for. See
+ *         @ref ssd1306_write_str_portrait.
  */
 enum ssd1306_err ssd1306_write_str(struct ssd1306_ctx *ctx, const uint8_t *str);
 
+/**
+ * Appends the glyph of a character to @c chunk instead of writing it right
+ * away, so that consecutive glyphs share transfers.
+ *
+ * Don't forget to call @ref ssd1306_chunk_flush once you're done.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param chunk staging buffer to append the glyph to
+ * @param c     character to append
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font has no glyph for @c c
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_emit_char(struct ssd1306_ctx *ctx,
+                                   struct ssd1306_data_chunk *chunk, uint8_t c);
+
 /**
  * Writes a character to the display.
  *
  * @param ctx struct that contains the platform dependent I/O
  * @param c   character to write to the display
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
  */
 enum ssd1306_err ssd1306_write_char(struct ssd1306_ctx *ctx, uint8_t c);
 
+/**
+ * Writes a string to the display with every glyph scaled up by @c scale.
+ *
+ * Each column of the font expands into @c scale columns and each of its pages
+ * into @c scale pages. The expansion is done with small lookup tables, a whole
+ * byte at a time, so it is cheap enough to redraw a large clock every second on
+ * a small microcontroller.
+ *
+ * The string is written into a window whose top left corner is @c col and
+ * @c page. This function changes the column and page ranges to that window and
+ * assumes @ref SSD1306_HORIZ_ADDR_MODE.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param col   left most column of the window
+ * @param page  top most page of the window
+ * @param str   string to write to the display
+ * @param scale factor to scale the font by, 1 to @ref SSD1306_MAX_TEXT_SCALE
+ *
+ * @return @ref SSD1306_SCALE_UNSUPPORTED if @c scale is out of range
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the text doesn't fit on the display
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font is missing a glyph
+ */
+enum ssd1306_err ssd1306_write_str_scaled(struct ssd1306_ctx *ctx,
+                                          enum ssd1306_col col,
+                                          enum ssd1306_page page,
+                                          const uint8_t *str, uint8_t scale);
+
+/**
+ * Writes a character to the display scaled up by @c scale.
+ *
+ * @see ssd1306_write_str_scaled
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param col   left most column of the glyph
+ * @param page  top most page of the glyph
+ * @param c     character to write to the display
+ * @param scale factor to scale the font by, 1 to @ref SSD1306_MAX_TEXT_SCALE
+ */
+enum ssd1306_err ssd1306_write_char_scaled(struct ssd1306_ctx *ctx,
+                                           enum ssd1306_col col,
+                                           enum ssd1306_page page, uint8_t c,
+                                           uint8_t scale);
+
+/**
+ * Renders a string into memory instead of the display.
+ *
+ * The bytes are produced in the order @ref SSD1306_HORIZ_ADDR_MODE consumes
+ * them for a window that's exactly as big as the text: the first page of every
+ * glyph, followed by the second page of every glyph and so on.
+ *
+ * @param font         font to render the string with
+ * @param str          string to render
+ * @param scale        factor to scale the font by, 1 to
+ *                     @ref SSD1306_MAX_TEXT_SCALE
+ * @param inverted     invert every rendered pixel
+ * @param dst          buffer to render into
+ * @param dst_len      length of @c dst
+ * @param rendered_len set to the number of bytes placed in @c dst
+ *
+ * @return @ref SSD1306_SCALE_UNSUPPORTED if @c scale is out of range
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font is missing a glyph
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c dst can't hold the result
+ */
+enum ssd1306_err ssd1306_render_str_scaled(const struct ssd1306_font *font,
+                                           const uint8_t *str, uint8_t scale,
+                                           bool inverted, uint8_t *dst,
+                                           size_t dst_len,
+                                           size_t *rendered_len);
+
+/**
+ * Transposes every glyph of @c font for a display rotated a quarter turn with
+ * @ref ssd1306_set_rotation.
+ *
+ * The transposed font describes glyphs the way the display sees them: a glyph
+ * @c width columns by @c pages pages becomes @c pages * 8 columns by
+ * @c width / 8 pages, in the same page by page layout. Rendering text with it
+ * is then a straight copy, see @ref ssd1306_write_str_portrait.
+ *
+ * This is meant to be run offline or at start-up, not per frame.
+ *
+ * @c transposed points into @c dst afterwards, so it must outlive it.
+ *
+ * @param font       font to transpose. Its @c width must be a multiple of 8.
+ * @param dst        buffer to transpose into, as long as @c font's glyphs
+ * @param dst_len    length of @c dst
+ * @param transposed font to fill out
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if @c font's width isn't a multiple
+ *         of 8
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c dst can't hold the glyphs
+ */
+enum ssd1306_err ssd1306_transpose_font(const struct ssd1306_font *font,
+                                        uint8_t *dst, size_t dst_len,
+                                        struct ssd1306_font *transposed);
+
+/**
+ * Writes a string to a display rotated a quarter turn, with a font made by
+ * @ref ssd1306_transpose_font.
+ *
+ * Coordinates are those of the rotated screen, the same ones a portrait
+ * @ref ssd1306_fb uses. The text runs down the display's pages, so every glyph
+ * is a whole number of pages and the string goes out through a single window
+ * in @ref SSD1306_HORIZ_ADDR_MODE, batched exactly like
+ * @ref ssd1306_write_str. This function changes the column and page ranges to
+ * that window.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param font transposed font to write the string with
+ * @param x    left most column of the text on the rotated screen, a multiple
+ *             of 8
+ * @param page top most page of the text on the rotated screen
+ * @param str  string to write to the display
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if @c x isn't a multiple of 8 or the
+ *         text doesn't fit on the display
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font is missing a glyph
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display isn't rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_write_str_portrait(struct ssd1306_ctx *ctx,
+                                            const struct ssd1306_font *font,
+                                            uint8_t x, uint8_t page,
+                                            const uint8_t *str);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,198 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_FRAME_H
+#define LIBSSD1306_SSD1306_FRAME_H
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup frame Frame Timing
+ *
+ * Tear-free flushing. The display scans its rows top to bottom once per
+ * frame, at a rate set by the registers in @ref ssd1306_timing:
+ *
+ *     F_frm = F_osc / (D * K * mux), K = phase 1 + phase 2 + 50 DCLKs
+ *
+ * A band of rows tears when the scan passes through it while it's being
+ * written. @ref ssd1306_frame_fb_flush sends each window of a framebuffer
+ * only when, according to the bus model, the write finishes before the scan
+ * reaches the window's rows: the write pointer stays ahead of the scan line.
+ *
+ * The period comes from the programmed registers and the datasheet's typical
+ * oscillator frequencies, which vary by about 10% between parts. The scan's
+ * phase is unknown until @ref ssd1306_frame_clock_sync is given the time a
+ * frame started, for instance from the @c FR pin. Each sync also corrects the
+ * period, so the clock stays locked to the panel.
+ *
+ * Rows are the display's, top to bottom, with the start line at 0 and no
+ * vertical remapping or offset.
+ */
+
+/** @{ */
+
+/**
+ * A user supplied time source.
+ *
+ * @param user @ref ssd1306_frame_clock::user
+ *
+ * @return the current time, in nanoseconds, from a monotonic clock
+ */
+typedef uint64_t (*ssd1306_now_ns_cb)(void *user);
+
+/**
+ * A user supplied delay.
+ *
+ * @param user @ref ssd1306_frame_clock::user
+ * @param ns   time to wait, in nanoseconds
+ */
+typedef void (*ssd1306_sleep_ns_cb)(void *user, uint32_t ns);
+
+/**
+ * Estimates the display's frame period from the timing registers programmed
+ * through @c ctx, using reset values for the ones that weren't.
+ *
+ * @param ctx struct that contains the programmed timing
+ *
+ * @return the period, in nanoseconds, or 0 if @c ctx is @c NULL
+ */
+uint32_t ssd1306_frame_period_ns(const struct ssd1306_ctx *ctx);
+
+/**
+ * Tracks where the display's scan is. Initialize it with
+ * @ref ssd1306_frame_clock_init.
+ */
+struct ssd1306_frame_clock {
+    /**
+     * Reads the time.
+     */
+    ssd1306_now_ns_cb now_ns;
+    /**
+     * **Optional**, waits for a flush. When @c NULL, flushes spin on
+     * @c now_ns.
+     */
+    ssd1306_sleep_ns_cb sleep_ns;
+    /**
+     * Passed to @c now_ns and @c sleep_ns.
+     */
+    void *user;
+    /**
+     * Frame period, in nanoseconds.
+     */
+    uint32_t period_ns;
+    /**
+     * Rows scanned per frame.
+     */
+    uint16_t rows;
+    /**
+     * Time a frame started at.
+     */
+    uint64_t frame_start_ns;
+    /**
+     * Whether @c frame_start_ns came from @ref ssd1306_frame_clock_sync.
+     */
+    bool synced;
+};
+
+/**
+ * Sets up a frame clock from the timing programmed through @c ctx. Until the
+ * first sync, frames are assumed to start now.
+ *
+ * @param clock    clock to initialize
+ * @param ctx      struct that contains the programmed timing
+ * @param now_ns   time source
+ * @param sleep_ns delay, may be @c NULL
+ * @param user     passed to @c now_ns and @c sleep_ns
+ *
+ * @return @ref SSD1306_DATA_LIST_NULL if @c clock or @c now_ns is @c NULL
+ */
+enum ssd1306_err ssd1306_frame_clock_init(struct ssd1306_frame_clock *clock,
+                                          const struct ssd1306_ctx *ctx,
+                                          ssd1306_now_ns_cb now_ns,
+                                          ssd1306_sleep_ns_cb sleep_ns,
+                                          void *user);
+
+/**
+ * Locks the clock's phase to a frame that started at @c frame_start_ns and
+ * nudges its period towards the one measured since the last sync.
+ *
+ * @param clock          clock to sync
+ * @param frame_start_ns time a frame started, from the clock's time source
+ */
+void ssd1306_frame_clock_sync(struct ssd1306_frame_clock *clock,
+                              uint64_t frame_start_ns);
+
+/**
+ * Finds the row being scanned.
+ *
+ * @param clock  clock to read
+ * @param now_ns current time
+ *
+ * @return the row, from 0 to @ref ssd1306_frame_clock::rows - 1
+ */
+uint16_t ssd1306_frame_clock_scan_row(const struct ssd1306_frame_clock *clock,
+                                      uint64_t now_ns);
+
+/**
+ * Finds how long to wait before writing rows @c first_row to @c last_row so
+ * the scan doesn't pass through them during the write.
+ *
+ * Rows are rows of the scan, not of RAM: with the start line at @c s, RAM row
+ * @c r is scanned as row @c (r - s) % 64. A band that wraps from the bottom
+ * of the scan to the top is passed with @c last_row in the next frame, up to
+ * twice @ref ssd1306_frame_clock::rows.
+ *
+ * @param clock     clock to read
+ * @param now_ns    current time
+ * @param first_row first scan row written
+ * @param last_row  last scan row written
+ * @param write_ns  time the write takes
+ *
+ * @return the wait, in nanoseconds. 0 when the write can start right away or
+ *         is too long to ever dodge the scan.
+ */
+uint32_t ssd1306_frame_clock_wait_ns(const struct ssd1306_frame_clock *clock,
+                                     uint64_t now_ns, uint16_t first_row,
+                                     uint16_t last_row, uint32_t write_ns);
+
+/**
+ * Flushes the dirty parts of a framebuffer like @ref ssd1306_fb_flush, but
+ * times each window so the scan never passes through it while it's written.
+ * Windows are only merged across pages while the merged write can still dodge
+ * the scan. Pages are placed on the scan with the start line last set through
+ * @ref ssd1306_set_start_line, so flushes stay tear-free while a
+ * @ref console, @ref flip or @ref viewport moves it.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param clock clock locked to the display
+ * @param bus   model of the bus, used to estimate how long windows take
+ * @param fb    framebuffer to flush
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the framebuffer is bigger than the
+ *         display
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, which turns the framebuffer's pages across the scan
+ */
+enum ssd1306_err ssd1306_frame_fb_flush(struct ssd1306_ctx *ctx,
+                                        const struct ssd1306_frame_clock *clock,
+                                        const struct ssd1306_bus_model *bus,
+                                        struct ssd1306_fb *fb);
+
+/** @} */ /* frame */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_FRAME_H */
@@ -0,0 +1,223 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_GRAY_H
+#define LIBSSD1306_SSD1306_GRAY_H
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/shadow.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup gray Grayscale
+ *
+ * Grayscale on a monochrome display by frame-rate control: the image is split
+ * into bitplanes and each plane is shown for a time proportional to its
+ * weight, so a pixel is lit for a fraction of every cycle that matches its
+ * level.
+ *
+ * A @ref ssd1306_gray_fb stores its pixels as 2 or 4 planes, each laid out
+ * like the display's RAM (see @ref framebuffer). Plane @c k holds bit @c k of
+ * every pixel's level and is shown for @c 2^k slots, so a cycle takes 3 slots
+ * at 2 bpp and 15 at 4 bpp. Slots as short as the display's frame period work
+ * best; longer ones flicker, 4 bpp noticeably so.
+ *
+ * @ref ssd1306_gray_sched_tick switches planes. It sends only the bytes that
+ * differ from the plane on display through a @ref ssd1306_shadow, within the
+ * time a slot lasts on the bus. A plane that doesn't fit is finished on the
+ * following ticks before its slots start counting, which keeps the levels
+ * right at the cost of a longer cycle.
+ */
+
+/** @{ */
+
+/**
+ * Calculates the number of bytes a grayscale framebuffer needs.
+ *
+ * @param width  width of the framebuffer, in columns
+ * @param height height of the framebuffer, in rows
+ * @param bpp    bits per pixel, 2 or 4
+ */
+#define SSD1306_GRAY_LEN(width, height, bpp)                                   \
+    (SSD1306_FB_LEN(width, height) * (size_t)(bpp))
+
+/**
+ * A grayscale framebuffer. Initialize it with @ref ssd1306_gray_init.
+ */
+struct ssd1306_gray_fb {
+    /**
+     * Bitplanes, one after the other, @ref SSD1306_FB_LEN bytes each. Use
+     * @ref ssd1306_gray_plane to find one.
+     */
+    uint8_t *buf;
+    /**
+     * Width, in columns.
+     */
+    uint16_t width;
+    /**
+     * Height, in rows. Always a multiple of @ref SSD1306_ROWS_PER_PAGE.
+     */
+    uint16_t height;
+    /**
+     * Bits per pixel, which is also the number of planes.
+     */
+    uint8_t bpp;
+};
+
+/**
+ * Sets up a grayscale framebuffer on top of @c buf and clears it.
+ *
+ * @param gray   framebuffer to initialize
+ * @param buf    storage for the planes, @ref SSD1306_GRAY_LEN bytes
+ * @param width  width of the framebuffer, in columns
+ * @param height height of the framebuffer, in rows (multiple of 8)
+ * @param bpp    bits per pixel, 2 or 4
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the dimensions are zero, too big
+ *         for the display's RAM or @c height isn't a multiple of 8
+ * @return @ref SSD1306_DEPTH_UNSUPPORTED if @c bpp isn't 2 or 4
+ */
+enum ssd1306_err ssd1306_gray_init(struct ssd1306_gray_fb *gray, uint8_t *buf,
+                                   uint16_t width, uint16_t height,
+                                   uint8_t bpp);
+
+/**
+ * Sets every pixel to level 0.
+ *
+ * @param gray framebuffer to clear
+ */
+void ssd1306_gray_clear(struct ssd1306_gray_fb *gray);
+
+/**
+ * Sets a pixel's level. Pixels outside the framebuffer are ignored.
+ *
+ * @param gray  framebuffer to draw in
+ * @param x     column of the pixel
+ * @param y     row of the pixel
+ * @param level level from 0 (off) to @c 2^bpp - 1 (fully on), clamped
+ */
+void ssd1306_gray_set_pixel(struct ssd1306_gray_fb *gray, int16_t x,
+                            int16_t y, uint8_t level);
+
+/**
+ * Reads a pixel's level.
+ *
+ * @param gray framebuffer to read from
+ * @param x    column of the pixel
+ * @param y    row of the pixel
+ *
+ * @return the level, or 0 for pixels outside the framebuffer
+ */
+uint8_t ssd1306_gray_get_pixel(const struct ssd1306_gray_fb *gray, int16_t x,
+                               int16_t y);
+
+/**
+ * Finds a bitplane.
+ *
+ * @param gray  framebuffer the plane belongs to
+ * @param plane plane to find, 0 being the least significant
+ *
+ * @return the plane, laid out like the display's RAM
+ */
+uint8_t *ssd1306_gray_plane(const struct ssd1306_gray_fb *gray,
+                            uint8_t plane);
+
+/**
+ * Quantizes an 8 bit grayscale image to the framebuffer's levels and splits
+ * it into its planes.
+ *
+ * @param gray       framebuffer to load into
+ * @param src        first row of the image, @c gray->width by
+ *                   @c gray->height pixels, 0 being black and 255 white
+ * @param src_stride bytes from one row of the image to the next
+ */
+void ssd1306_gray_load(struct ssd1306_gray_fb *gray, const uint8_t *src,
+                       size_t src_stride);
+
+/**
+ * Shows the planes of a grayscale framebuffer in turn. Initialize it with
+ * @ref ssd1306_gray_sched_init.
+ */
+struct ssd1306_gray_sched {
+    /**
+     * Framebuffer being shown.
+     */
+    const struct ssd1306_gray_fb *gray;
+    /**
+     * What the display's RAM holds.
+     */
+    struct ssd1306_shadow *shadow;
+    /**
+     * Bus model that turns @c slot_ns into a budget.
+     */
+    const struct ssd1306_bus_model *bus;
+    /**
+     * Length of a slot, in nanoseconds.
+     */
+    uint32_t slot_ns;
+    /**
+     * Plane being shown or sent.
+     */
+    uint8_t plane;
+    /**
+     * Slots the plane stays up for, including the current one.
+     */
+    uint8_t slots_left;
+    /**
+     * Whether the plane is still being sent.
+     */
+    bool pending;
+};
+
+/**
+ * Sets up a scheduler. The first tick sends plane 0.
+ *
+ * @param sched   scheduler to initialize
+ * @param gray    framebuffer to show
+ * @param shadow  shadow of the display's RAM, as big as @c gray
+ * @param bus     bus model, or @c NULL to send a plane's differences in one
+ *                tick however long it takes
+ * @param slot_ns length of a slot, in nanoseconds
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the shadow and the framebuffer
+ *         differ in size
+ */
+enum ssd1306_err ssd1306_gray_sched_init(struct ssd1306_gray_sched *sched,
+                                         const struct ssd1306_gray_fb *gray,
+                                         struct ssd1306_shadow *shadow,
+                                         const struct ssd1306_bus_model *bus,
+                                         uint32_t slot_ns);
+
+/**
+ * Advances the scheduler by a slot. Call it once per slot, from a timer or
+ * after waiting for the display's frame.
+ *
+ * When the current plane's slots are over, the next plane's differences are
+ * sent, as many as fit in @ref ssd1306_gray_sched::slot_ns.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param sched scheduler to advance
+ *
+ * @return see @ref ssd1306_shadow_flush
+ */
+enum ssd1306_err ssd1306_gray_sched_tick(struct ssd1306_ctx *ctx,
+                                         struct ssd1306_gray_sched *sched);
+
+/** @} */ /* gray */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_GRAY_H */
@@ -0,0 +1,129 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_IMAGE_H
+#define LIBSSD1306_SSD1306_IMAGE_H
+
+#include "ssd1306/blit.h"
+#include "ssd1306/dither.h"
+#include "ssd1306/err.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup image Image Import
+ *
+ * Converts images to @ref ssd1306_bitmap. Images are read from memory, so a
+ * file can be imported without copying it by @c mmap'ing it (or by linking it
+ * into flash) and passing the mapping in.
+ *
+ * | Format | Pixels                                | Lit pixels  | Limits    |
+ * | ------ | ------------------------------------- | ----------- | --------- |
+ * | PBM    | binary (@c P4), 1bpp                  | clear bits  | none      |
+ * | PGM    | binary (@c P5), 8/16 bit gray, dither | bright gray | max width |
+ * | XBM    | C source, 1bpp                        | clear bits  | max width |
+ *
+ * Every format lights the pixels that are white in the image, so the same
+ * artwork looks the same whichever format it's exported in. Set bits of PBM
+ * and XBM are black (ink), which leaves them off. Artwork drawn dark on light
+ * that should be lit where it's dark, like most icons made for OLEDs, is
+ * imported with @c inverted set.
+ *
+ * Images limited in width can't be wider than
+ * @ref SSD1306_IMAGE_MAX_WIDTH. Only the first image of a PBM or PGM file is
+ * imported.
+ */
+
+/** @{ */
+
+/**
+ * Format of an image.
+ */
+enum ssd1306_image_format {
+    SSD1306_IMAGE_PBM, /**< Binary portable bitmap (@c P4). */
+    SSD1306_IMAGE_PGM, /**< Binary portable graymap (@c P5). */
+    SSD1306_IMAGE_XBM, /**< X BitMap. */
+};
+
+/**
+ * An image whose header has been parsed by @ref ssd1306_image_parse.
+ */
+struct ssd1306_image {
+    /**
+     * Format of the image.
+     */
+    enum ssd1306_image_format format;
+    /**
+     * Width, in pixels.
+     */
+    uint16_t width;
+    /**
+     * Height, in pixels.
+     */
+    uint16_t height;
+    /**
+     * Level of white for PGM, 1 otherwise.
+     */
+    uint16_t maxval;
+    /**
+     * The image's pixels, right after the header. For XBM, it's the text
+     * after the opening brace of the array.
+     */
+    const uint8_t *raster;
+    /**
+     * Number of bytes from @c raster to the end of the image's data.
+     */
+    size_t raster_len;
+};
+
+/**
+ * Parses an image's header and finds its pixels. Use it to size the buffer of
+ * @ref ssd1306_image_to_bitmap with @ref SSD1306_BITMAP_LEN.
+ *
+ * @param data  the image's data
+ * @param len   length of @c data
+ * @param image where to place the result
+ *
+ * @return @ref SSD1306_IMAGE_MALFORMED if the format isn't recognized or the
+ *         header is malformed
+ */
+enum ssd1306_err ssd1306_image_parse(const uint8_t *data, size_t len,
+                                     struct ssd1306_image *image);
+
+/**
+ * Converts an image to a page-major bitmap.
+ *
+ * @param image    image parsed by @ref ssd1306_image_parse
+ * @param dither   how PGM gray levels are turned into pixels, ignored for 1bpp
+ *                 formats
+ * @param inverted light the image's black pixels instead of its white ones
+ * @param dst      where to place the bitmap's pixels
+ * @param len      length of @c dst
+ * @param bitmap   set to describe the bitmap in @c dst
+ *
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c dst is shorter than
+ *         @ref SSD1306_BITMAP_LEN
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the image is too wide
+ * @return @ref SSD1306_IMAGE_MALFORMED if the image's pixels are truncated or
+ *         malformed
+ */
+enum ssd1306_err ssd1306_image_to_bitmap(const struct ssd1306_image *image,
+                                         enum ssd1306_dither dither,
+                                         bool inverted, uint8_t *dst,
+                                         size_t len,
+                                         struct ssd1306_bitmap *bitmap);
+
+/** @} */ /* image */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_IMAGE_H */
@@ -0,0 +1,149 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_LABEL_CACHE_H
+#define LIBSSD1306_SSD1306_LABEL_CACHE_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup label_cache Label Cache
+ *
+ * Menus and dashboards redraw the same short strings over and over. The label
+ * cache keeps the rendered bytes of recently drawn labels around so that
+ * redrawing one is a single @ref ssd1306_write_data_list call instead of a walk
+ * through the font tables.
+ *
+ * The cache has a fixed number of entries, supplied by the application, and
+ * evicts the least recently used label when it's full. Entries are keyed on
+ * the font, the string and the style the label was rendered with.
+ */
+
+/** @{ */
+
+/**
+ * Longest string, in characters, an entry of the cache can hold.
+ */
+#ifndef SSD1306_LABEL_MAX_LEN
+#define SSD1306_LABEL_MAX_LEN 8
+#endif
+
+/**
+ * Number of rendered bytes an entry of the cache can hold. The default fits
+ * @ref SSD1306_LABEL_MAX_LEN characters of @ref ssd1306_font8x8_basic at a
+ * scale of 1.
+ */
+#ifndef SSD1306_LABEL_MAX_BYTES
+#define SSD1306_LABEL_MAX_BYTES (SSD1306_LABEL_MAX_LEN * 8)
+#endif
+
+/**
+ * How a label is rendered. Part of the key of a cache entry.
+ */
+struct ssd1306_label_style {
+    uint8_t scale; /**< See @ref ssd1306_write_str_scaled */
+    bool inverted; /**< Invert every pixel of the label. */
+};
+
+/**
+ * A rendered label. Treat the fields as private.
+ */
+struct ssd1306_label_entry {
+    const struct ssd1306_font *font;
+    struct ssd1306_label_style style;
+    uint8_t str[SSD1306_LABEL_MAX_LEN];
+    uint8_t str_len;
+    bool valid;
+
+    /** Value of @ref ssd1306_label_cache::clock when last used. */
+    uint32_t last_used;
+
+    uint16_t cols;  /**< Width of the label, in columns. */
+    uint8_t pages;  /**< Height of the label, in pages. */
+    uint16_t bytes; /**< Number of valid bytes in @c run. */
+    uint8_t run[SSD1306_LABEL_MAX_BYTES];
+};
+
+/**
+ * The cache. Initialize it with @ref ssd1306_label_cache_init.
+ */
+struct ssd1306_label_cache {
+    struct ssd1306_label_entry *entries; /**< Storage for the labels. */
+    size_t num_entries;                  /**< Length of @c entries. */
+
+    /** Incremented on every lookup, used to find the least recently used. */
+    uint32_t clock;
+
+    uint32_t hits;      /**< Labels that were found in the cache. */
+    uint32_t misses;    /**< Labels that had to be rendered. */
+    uint32_t evictions; /**< Misses that had to throw out a cached label. */
+};
+
+/**
+ * Prepares an empty cache.
+ *
+ * @param cache       cache to initialize
+ * @param entries     storage for the cached labels
+ * @param num_entries length of @c entries
+ */
+void ssd1306_label_cache_init(struct ssd1306_label_cache *cache,
+                              struct ssd1306_label_entry *entries,
+                              size_t num_entries);
+
+/**
+ * Throws out every cached label. The counters are left untouched.
+ *
+ * Call this if the glyphs of a font change.
+ *
+ * @param cache cache to empty
+ */
+void ssd1306_label_cache_clear(struct ssd1306_label_cache *cache);
+
+/**
+ * Writes a label to the display, rendering it only if it isn't cached.
+ *
+ * The label is rendered with @ref ssd1306_get_font and written into a window
+ * whose top left corner is @c col and @c page. This function changes the
+ * column and page ranges to that window and assumes
+ * @ref SSD1306_HORIZ_ADDR_MODE.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param cache cache to look the label up in
+ * @param col   left most column of the label
+ * @param page  top most page of the label
+ * @param str   label to write
+ * @param style how to render the label
+ *
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if the label is longer than
+ *         @ref SSD1306_LABEL_MAX_LEN or renders to more than
+ *         @ref SSD1306_LABEL_MAX_BYTES
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the label doesn't fit on the display
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ * @return the errors of @ref ssd1306_render_str_scaled
+ */
+enum ssd1306_err ssd1306_write_label(struct ssd1306_ctx *ctx,
+                                     struct ssd1306_label_cache *cache,
+                                     enum ssd1306_col col,
+                                     enum ssd1306_page page, const uint8_t *str,
+                                     struct ssd1306_label_style style);
+
+/** @} */ /* label_cache */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_LABEL_CACHE_H */
@@ -0,0 +1,117 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_MARQUEE_H
+#define LIBSSD1306_SSD1306_MARQUEE_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup marquee Marquee
+ *
+ * A line of text that scrolls left forever, moved by the display's horizontal
+ * scroll. Every scroll step the leftmost column of the ticker's pages wraps
+ * around to the right edge. @ref ssd1306_marquee_tick works out from a frame
+ * clock how many steps were taken since the last tick and writes the next
+ * columns of the text over the ones that wrapped around: a few bytes per
+ * column instead of rewriting the ticker's pages.
+ *
+ * The text repeats once it runs out, so end it with a few spaces.
+ *
+ * The ticker uses the display's scroll, so nothing else can scroll while it
+ * runs. Flushes pause and resume it (see @ref ssd1306_pause_scrolling), which
+ * delays it by up to a step. The ticker sets @ref ssd1306_scroll::clock so
+ * the steps are counted across those restarts.
+ */
+
+/** @{ */
+
+/**
+ * A ticker. Initialize it with @ref ssd1306_marquee_init.
+ */
+struct ssd1306_marquee {
+    /**
+     * Font the text is drawn with.
+     */
+    const struct ssd1306_font *font;
+    /**
+     * Text to show. It isn't copied.
+     */
+    const uint8_t *text;
+    /**
+     * Length of @c text.
+     */
+    size_t len;
+    /**
+     * First page of the ticker.
+     */
+    enum ssd1306_page first_page;
+    /**
+     * Column of the text, counting from its first glyph, that goes in next.
+     */
+    uint32_t next_col;
+    /**
+     * Value of @ref ssd1306_scroll_steps the text was last fed up to.
+     */
+    uint32_t steps_fed;
+};
+
+/**
+ * Draws the first screenful of text across the ticker's pages and starts
+ * scrolling them left.
+ *
+ * @param ctx        struct that contains the platform dependent I/O
+ * @param marquee    ticker to initialize
+ * @param clock      clock locked to the display. It must outlive the scroll.
+ * @param first_page first page of the ticker, which is as tall as the font
+ * @param interval   frames between scroll steps
+ * @param text       text to show
+ * @param len        length of @c text, at least 1
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the ticker doesn't fit on the
+ *         display, @ref SSD1306_GLYPH_NOT_IN_FONT if the font has no glyph
+ *         for one of the characters
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, which would scroll the ticker along its height
+ */
+enum ssd1306_err ssd1306_marquee_init(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_marquee *marquee,
+                                      const struct ssd1306_frame_clock *clock,
+                                      enum ssd1306_page first_page,
+                                      enum ssd1306_scroll_step interval,
+                                      const uint8_t *text, size_t len);
+
+/**
+ * Writes the text's next columns over the ones that wrapped around since the
+ * last tick. Sends nothing if the scroll hasn't taken a step. Tick at least
+ * once per screen width of steps.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param marquee ticker to update
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_marquee_tick(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_marquee *marquee);
+
+/** @} */ /* marquee */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_MARQUEE_H */
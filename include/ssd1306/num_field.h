@@ -0,0 +1,125 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_NUM_FIELD_H
+#define LIBSSD1306_SSD1306_NUM_FIELD_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup num_field Numeric Fields
+ *
+ * A numeric field is a fixed-width, right aligned number at a fixed position
+ * on the display. The field remembers the characters it last wrote, so
+ * updating it only rewrites the glyphs that actually changed. A counter going
+ * from 1299 to 1300 rewrites three glyphs, a clock's seconds usually one.
+ *
+ * Formatting is done by the field itself, no @c snprintf involved.
+ */
+
+/** @{ */
+
+/**
+ * Widest field, in characters, including a sign and a decimal point.
+ */
+#ifndef SSD1306_NUM_FIELD_MAX_LEN
+#define SSD1306_NUM_FIELD_MAX_LEN 12
+#endif
+
+/**
+ * A numeric field. Initialize it with @ref ssd1306_num_field_init and treat the
+ * fields as read-only afterwards.
+ */
+struct ssd1306_num_field {
+    enum ssd1306_col col;   /**< Left most column of the field. */
+    enum ssd1306_page page; /**< Top most page of the field. */
+
+    uint8_t len;      /**< Width of the field, in characters. */
+    uint8_t decimals; /**< Digits after the decimal point. */
+    uint8_t scale;    /**< See @ref ssd1306_write_str_scaled */
+    uint8_t pad;      /**< Character the number is padded with on the left. */
+
+    /**
+     * Whether @c shown reflects the display. When @c false, the next update
+     * redraws the whole field.
+     */
+    bool valid;
+    /**
+     * Characters currently on the display.
+     */
+    uint8_t shown[SSD1306_NUM_FIELD_MAX_LEN];
+};
+
+/**
+ * Sets a field up. Nothing is written to the display until the first
+ * @ref ssd1306_num_field_update.
+ *
+ * @param field    field to initialize
+ * @param col      left most column of the field
+ * @param page     top most page of the field
+ * @param len      width of the field, in characters, up to
+ *                 @ref SSD1306_NUM_FIELD_MAX_LEN
+ * @param decimals digits after the decimal point. The value passed in to
+ *                 @ref ssd1306_num_field_update is scaled by @c 10^decimals,
+ *                 (i.e. @c 2315 with 2 decimals is shown as @c 23.15).
+ * @param scale    factor to scale the font by, 1 to
+ *                 @ref SSD1306_MAX_TEXT_SCALE
+ * @param pad      character to pad the number with, usually @c ' ' or @c '0'
+ *
+ * @return @ref SSD1306_DATA_LIST_NULL if @c field is @c NULL
+ * @return @ref SSD1306_SCALE_UNSUPPORTED if @c scale is out of range
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c len is 0, too wide or can't
+ *         hold @c decimals
+ */
+enum ssd1306_err ssd1306_num_field_init(struct ssd1306_num_field *field,
+                                        enum ssd1306_col col,
+                                        enum ssd1306_page page, uint8_t len,
+                                        uint8_t decimals, uint8_t scale,
+                                        uint8_t pad);
+
+/**
+ * Forces the next update to redraw the whole field. Call it whenever
+ * something else has drawn over the field.
+ *
+ * @param field field to invalidate
+ */
+void ssd1306_num_field_invalidate(struct ssd1306_num_field *field);
+
+/**
+ * Shows @c value in the field, only writing the glyphs that changed.
+ *
+ * Each run of changed characters is written in its own window with
+ * @ref ssd1306_write_str_scaled, so this function changes the column and page
+ * ranges and assumes @ref SSD1306_HORIZ_ADDR_MODE.
+ *
+ * @param ctx   struct that contains the platform dependent I/O
+ * @param field field to update
+ * @param value value to show
+ *
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c value doesn't fit in the field.
+ *         The field is left untouched.
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn. The field is left untouched.
+ * @return the errors of @ref ssd1306_write_str_scaled
+ */
+enum ssd1306_err ssd1306_num_field_update(struct ssd1306_ctx *ctx,
+                                          struct ssd1306_num_field *field,
+                                          int32_t value);
+
+/** @} */ /* num_field */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_NUM_FIELD_H */
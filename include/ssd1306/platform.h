@@ -28,6 +28,114 @@ extern "C" {
  */
 struct ssd1306_ctx;
 
+/**
+ * Bits of @ref ssd1306_timing::programmed, one per register the library has
+ * written.
+ */
+enum ssd1306_timing_field {
+    SSD1306_TIMING_CLOCK = 0x01,       /**< @ref ssd1306_timing::clock */
+    SSD1306_TIMING_PRECHARGE = 0x02,   /**< @ref ssd1306_timing::precharge */
+    SSD1306_TIMING_ACTIVE_ROWS = 0x04, /**< @ref ssd1306_timing::active_rows */
+};
+
+/**
+ * The registers that set the display's refresh rate, as last programmed
+ * through this library. Registers that were never programmed hold their reset
+ * values on the display, whatever their field says.
+ *
+ * @see ssd1306_frame_period_ns
+ */
+struct ssd1306_timing {
+    /**
+     * Argument of @ref ssd1306_config_timing: oscillator frequency in bits
+     * 7-4, divide ratio minus 1 in bits 3-0.
+     */
+    uint8_t clock;
+    /**
+     * Argument of @ref ssd1306_set_precharge_period: phase 2 in bits 7-4,
+     * phase 1 in bits 3-0, in DCLKs.
+     */
+    uint8_t precharge;
+    /**
+     * Argument of @ref ssd1306_set_active_rows: active rows minus 1.
+     */
+    uint8_t active_rows;
+    /**
+     * Bitwise or'd @ref ssd1306_timing_field of the registers programmed.
+     */
+    uint8_t programmed;
+};
+
+/**
+ * Most bytes a scroll setup command takes, arguments included.
+ */
+#define SSD1306_SCROLL_SETUP_MAX_LEN 7
+
+/**
+ * Whether the display is scrolling, as far as this library knows.
+ */
+enum ssd1306_scroll_state {
+    SSD1306_SCROLL_STOPPED, /**< Not scrolling. */
+    SSD1306_SCROLL_RUNNING, /**< Scrolling. */
+    /**
+     * Stopped by @ref ssd1306_pause_scrolling, to be restarted by
+     * @ref ssd1306_resume_scrolling.
+     */
+    SSD1306_SCROLL_PAUSED,
+};
+
+struct ssd1306_frame_clock;
+
+/**
+ * The scroll configuration last sent through this library, so it can be
+ * restarted after the display's RAM is written.
+ */
+struct ssd1306_scroll {
+    /**
+     * The last horizontal or vertical and horizontal scroll setup command,
+     * with its arguments.
+     */
+    uint8_t setup[SSD1306_SCROLL_SETUP_MAX_LEN];
+    /**
+     * Length of @c setup, 0 if no scroll was set up.
+     */
+    uint8_t setup_len;
+    /**
+     * A @ref ssd1306_scroll_state.
+     */
+    uint8_t state;
+    /**
+     * Clock the scroll's steps are counted with, @c NULL if they aren't
+     * counted. The modules that keep up with the scroll, like the marquee,
+     * set it between the scroll setup and @ref ssd1306_start_scrolling. A
+     * new setup or @ref ssd1306_stop_scrolling forgets it, so it only has to
+     * outlive the scroll.
+     */
+    const struct ssd1306_frame_clock *clock;
+    /**
+     * Time the scroll last started or resumed at, read from @c clock.
+     */
+    uint64_t resumed_ns;
+    /**
+     * Steps taken since @ref ssd1306_start_scrolling, up to the last pause.
+     * The display starts a fresh step interval every time it starts
+     * scrolling, so each run's steps are counted on their own.
+     */
+    uint32_t steps;
+};
+
+/**
+ * How the panel is mounted, as a clockwise rotation of the picture.
+ */
+enum ssd1306_rotation {
+    SSD1306_ROTATE_0,   /**< Landscape, as wired. */
+    SSD1306_ROTATE_90,  /**< Portrait, the top edge on the right. */
+    SSD1306_ROTATE_180, /**< Landscape, upside down. */
+    SSD1306_ROTATE_270, /**< Portrait, the top edge on the left. */
+};
+
+struct ssd1306_font;
+
 /**
  * A callback typedef that is in charge of sending a command and that command's
  * argument(s), if it has any, to the SSD1306. The user can safely assume that
@@ -44,6 +152,24 @@ struct ssd1306_ctx;
 typedef enum ssd1306_err (*ssd1306_send_cmd_cb)(struct ssd1306_ctx *ctx,
                                                 uint8_t cmd);
 
+/**
+ * A callback typedef that is in charge of sending a list of commands and
+ * arguments to the SSD1306, as a single transaction. Like
+ * @ref ssd1306_write_data_list_cb for data, it lets one set the @c D/C line
+ * low, or send the I2C control byte, once for the whole list.
+ *
+ * The user can safely assume that @c ctx will be not be @c NULL.
+ *
+ * @param ctx          struct that contains the platform dependent I/O
+ * @param cmd_list     list of the commands/arguments
+ * @param cmd_list_len length of @c cmd_list
+ *
+ * @return an appropriate error code of type enum @ref ssd1306_err
+ */
+typedef enum ssd1306_err (*ssd1306_send_cmd_list_cb)(struct ssd1306_ctx *ctx,
+                                                     const uint8_t *cmd_list,
+                                                     size_t cmd_list_len);
+
 /**
  * A callback typedef that is in charge of writing data to the SSD1306's memory.
  * The user can safely assume that @c ctx will be not be @c NULL. Before
@@ -134,6 +260,47 @@ struct ssd1306_ctx {
      * Number of maximum rows the OLED supports.
      */
     const uint16_t height;
+
+    /**
+     * **Optional**, font used by the text rendering functions. Defaults to
+     * @ref ssd1306_font8x8_basic when @c NULL.
+     *
+     * Unlike the fields above, this one can be changed at any time.
+     */
+    const struct ssd1306_font *font;
+
+    /**
+     * **Optional**, how the panel is mounted. @ref ssd1306_init_display
+     * applies it; change it later with @ref ssd1306_set_rotation.
+     */
+    enum ssd1306_rotation rotation;
+
+    /**
+     * Display timing, kept up to date by the functions that program it. Leave
+     * it zeroed when initializing the struct.
+     */
+    struct ssd1306_timing timing;
+
+    /**
+     * Scroll configuration, kept up to date by the scrolling commands. Leave
+     * it zeroed when initializing the struct.
+     */
+    struct ssd1306_scroll scroll;
+
+    /**
+     * RAM row shown on the first row of the scan, kept up to date by
+     * @ref ssd1306_set_start_line. Leave it zeroed when initializing the
+     * struct.
+     */
+    uint8_t start_line;
+
+    /**
+     * **Optional**, user supplied callback that sends a list of commands to
+     * the SSD1306 in one transaction.
+     *
+     * Instead of calling this field directly, use @ref ssd1306_send_cmd_list.
+     */
+    const ssd1306_send_cmd_list_cb send_cmd_list;
 };
 
 /**
@@ -165,8 +332,10 @@ enum ssd1306_err ssd1306_send_cmd(struct ssd1306_ctx *ctx, uint8_t cmd);
  * Sends all of the commands present in @c cmd_list.
  *
  * This is useful when sending commands that require multiple arguments.
- * The commands are sent by calling @ref ssd1306_ctx::send_cmd on each command
- * in the list. @ref ssd1306_send_cmd_list returns immediately if
+ * Calls @ref ssd1306_ctx::send_cmd_list if it is not @c NULL.
+ *
+ * Otherwise, the commands are sent by calling @ref ssd1306_ctx::send_cmd on
+ * each command in the list. @ref ssd1306_send_cmd_list returns immediately if
  * @ref ssd1306_ctx::send_cmd returns anything other than @ref SSD1306_OK.
  *
  * @param ctx          struct that contains all of the platform dependent I/O
@@ -206,6 +375,76 @@ enum ssd1306_err ssd1306_write_data_list(struct ssd1306_ctx *ctx,
                                          const uint8_t *data_list,
                                          size_t data_list_len);
 
+/**
+ * Number of bytes a @ref ssd1306_data_chunk holds before it's handed off to
+ * @ref ssd1306_write_data_list.
+ *
+ * Override it on the command line if your @ref ssd1306_ctx::write_data_list
+ * benefits from longer transfers. The library and the application must agree
+ * on the value.
+ */
+#ifndef SSD1306_DATA_CHUNK_LEN
+#define SSD1306_DATA_CHUNK_LEN 32
+#endif
+
+/**
+ * A small staging buffer for data bytes that are produced one at a time
+ * (decoders, glyph renderers, etc..).
+ *
+ * Bytes are pushed with @ref ssd1306_chunk_push and sent with
+ * @ref ssd1306_write_data_list every time the buffer fills up, so the
+ * setup/teardown of a transfer happens once per @ref SSD1306_DATA_CHUNK_LEN
+ * bytes instead of once per byte.
+ *
+ * Zero-initialize it before the first push.
+ */
+struct ssd1306_data_chunk {
+    /**
+     * Bytes that haven't been written yet.
+     */
+    uint8_t data[SSD1306_DATA_CHUNK_LEN];
+    /**
+     * Number of valid bytes in @ref ssd1306_data_chunk::data.
+     */
+    size_t len;
+};
+
+/**
+ * Appends a byte to @c chunk, writing the chunk out first if it is full.
+ *
+ * @param ctx   struct that contains all of the platform dependent I/O
+ * @param chunk staging buffer to append to
+ * @param data  data to append
+ */
+enum ssd1306_err ssd1306_chunk_push(struct ssd1306_ctx *ctx,
+                                    struct ssd1306_data_chunk *chunk,
+                                    uint8_t data);
+
+/**
+ * Appends a list of bytes to @c chunk, writing the chunk out every time it
+ * fills up.
+ *
+ * @param ctx           struct that contains all of the platform dependent I/O
+ * @param chunk         staging buffer to append to
+ * @param data_list     list of data
+ * @param data_list_len length of @c data_list
+ */
+enum ssd1306_err ssd1306_chunk_push_list(struct ssd1306_ctx *ctx,
+                                         struct ssd1306_data_chunk *chunk,
+                                         const uint8_t *data_list,
+                                         size_t data_list_len);
+
+/**
+ * Writes out whatever is left in @c chunk and empties it.
+ *
+ * Always call this once you're done pushing bytes.
+ *
+ * @param ctx   struct that contains all of the platform dependent I/O
+ * @param chunk staging buffer to write out
+ */
+enum ssd1306_err ssd1306_chunk_flush(struct ssd1306_ctx *ctx,
+                                     struct ssd1306_data_chunk *chunk);
+
 /** @} */ /* platform_dependent_operations */
 
 #ifdef __cplusplus
@@ -0,0 +1,74 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_PRINTF_H
+#define LIBSSD1306_SSD1306_PRINTF_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/platform.h"
+
+#include <stdarg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup printf Formatted Output
+ *
+ * A small @c printf that renders straight into glyphs. There is no
+ * intermediate string and nothing from the C library's @c printf family is
+ * used, so pulling it in costs far less flash than @c vsnprintf does on most
+ * embedded C libraries and doesn't touch the heap.
+ *
+ * Conversions are written as
+ * `%[flags][width][.precision][length]conversion` where:
+ *
+ * | Part       | Supported                                                  |
+ * | ---------- | ---------------------------------------------------------- |
+ * | flags      | @c - (left align), @c 0 (pad with zeros), @c + (show sign) |
+ * | width      | minimum number of characters, digits or @c *               |
+ * | precision  | digits after the decimal point of @c f, digits or @c *     |
+ * | length     | @c l for @c long arguments                                 |
+ * | conversion | @c d @c i @c u @c x @c X @c c @c s @c f @c %               |
+ *
+ * @c f defaults to 6 decimals and supports up to 9. Its integer part must fit
+ * in an @c unsigned @c long; larger values are printed as @c ovf. Halves are
+ * rounded away from zero, so @c 2.5 prints as @c 3 with a precision of 0.
+ */
+
+/** @{ */
+
+/**
+ * Writes formatted text to the display, starting wherever the display's
+ * address pointer is, just like @ref ssd1306_write_str.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ * @param fmt format string
+ *
+ * @return @ref SSD1306_FORMAT_UNSUPPORTED if @c fmt contains an unsupported
+ *         conversion. Everything before it has been written.
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if the font is missing a glyph
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, like @ref ssd1306_write_str
+ */
+enum ssd1306_err ssd1306_printf(struct ssd1306_ctx *ctx, const char *fmt, ...);
+
+/**
+ * @ref ssd1306_printf with the arguments passed in as a @c va_list.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param fmt  format string
+ * @param args arguments of @c fmt
+ */
+enum ssd1306_err ssd1306_vprintf(struct ssd1306_ctx *ctx, const char *fmt,
+                                 va_list args);
+
+/** @} */ /* printf */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_PRINTF_H */
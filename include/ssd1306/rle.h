@@ -0,0 +1,265 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_RLE_H
+#define LIBSSD1306_SSD1306_RLE_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rle Compressed Bitmaps
+ *
+ * A run-length encoding tuned for data already laid out the way the
+ * @c SSD1306 expects it (1 bit per pixel, one byte per page column).
+ *
+ * Page bytes of fonts and icons are dominated by blank (@c 0x00) and solid
+ * (@c 0xFF) columns, so those runs get an opcode of their own that doesn't
+ * spend a byte on the value being repeated.
+ *
+ * An encoded stream is a sequence of operations. Each operation starts with a
+ * control byte. Its upper two bits select the operation (@ref ssd1306_rle_op)
+ * and its lower six bits hold a count:
+ *
+ * | Operation                  | Payload      | Decoded bytes          |
+ * | -------------------------- | ------------ | ---------------------- |
+ * | @ref SSD1306_RLE_LITERAL   | count + 1    | the payload            |
+ * | @ref SSD1306_RLE_ZEROS     | none         | count + 1 @c 0x00's    |
+ * | @ref SSD1306_RLE_ONES      | none         | count + 1 @c 0xFF's    |
+ * | @ref SSD1306_RLE_REPEAT    | 1            | count + 2 payload's    |
+ *
+ * Decoding never needs the whole asset in RAM. @ref ssd1306_write_rle decodes
+ * straight into a buffer of @ref SSD1306_DATA_CHUNK_LEN bytes and hands each
+ * full buffer to @ref ssd1306_write_data_list.
+ */
+
+/** @{ */
+
+/**
+ * The operations of the encoding. They occupy the upper two bits of an
+ * operation's control byte.
+ */
+enum ssd1306_rle_op {
+    SSD1306_RLE_LITERAL = 0x00, /**< Copy the bytes that follow. */
+    SSD1306_RLE_ZEROS = 0x40,   /**< Emit a run of @c 0x00. */
+    SSD1306_RLE_ONES = 0x80,    /**< Emit a run of @c 0xFF. */
+    SSD1306_RLE_REPEAT = 0xC0,  /**< Emit a run of the byte that follows. */
+};
+
+/**
+ * Masks the operation out of a control byte.
+ */
+#define SSD1306_RLE_OP_MASK 0xC0
+
+/**
+ * Masks the count out of a control byte.
+ */
+#define SSD1306_RLE_COUNT_MASK 0x3F
+
+/**
+ * State of a decoder that is in the middle of a stream. The decoder can be
+ * suspended between any two bytes, which is what lets the caller pick the size
+ * of the output buffer.
+ *
+ * Initialize it with @ref ssd1306_rle_decoder_init.
+ */
+struct ssd1306_rle_decoder {
+    const uint8_t *src; /**< Encoded stream. */
+    size_t src_len;     /**< Length of @c src. */
+    size_t pos;         /**< Index of the next unread byte in @c src. */
+
+    uint8_t op;        /**< Operation currently being decoded. */
+    uint8_t value;     /**< Byte being repeated by a run. */
+    uint8_t remaining; /**< Bytes left to produce for @c op. */
+};
+
+/**
+ * A font whose glyphs are stored compressed.
+ *
+ * Glyphs are grouped in blocks of @c glyphs_per_block glyphs and each block is
+ * encoded on its own. Looking up a glyph decodes, at most, the glyphs that
+ * precede it within its block. Bigger blocks compress better but cost more to
+ * look up.
+ *
+ * Create one with @ref ssd1306_rle_encode_font, or generate a constant one
+ * with @c ./extra/rle_font.c so it lives in flash.
+ */
+struct ssd1306_rle_font {
+    /**
+     * Encoded blocks, back to back.
+     */
+    const uint8_t *data;
+    /**
+     * Offset of each block within @c data. There's one more entry than there
+     * are blocks; the last entry is the length of @c data.
+     */
+    const uint16_t *block_offsets;
+
+    uint16_t num_glyphs;      /**< See @ref ssd1306_font::num_glyphs */
+    uint8_t width;            /**< See @ref ssd1306_font::width */
+    uint8_t pages;            /**< See @ref ssd1306_font::pages */
+    uint8_t first_char;       /**< See @ref ssd1306_font::first_char */
+    uint8_t glyphs_per_block; /**< Number of glyphs in each encoded block. */
+};
+
+/**
+ * @ref ssd1306_font8x8_basic, encoded in blocks of 8 glyphs.
+ *
+ * It's stored in flash as generated by @c ./extra/rle_font.c, so using it
+ * instead of @ref ssd1306_font8x8_basic saves flash as long as nothing else
+ * references the uncompressed font.
+ */
+extern const struct ssd1306_rle_font ssd1306_rle_font8x8_basic;
+
+/**
+ * Calculates the number of entries @ref ssd1306_rle_font::block_offsets needs.
+ *
+ * @param num_glyphs       number of glyphs in the font
+ * @param glyphs_per_block number of glyphs in each encoded block
+ */
+#define SSD1306_RLE_NUM_BLOCK_OFFSETS(num_glyphs, glyphs_per_block)            \
+    (((num_glyphs) + (glyphs_per_block)-1) / (glyphs_per_block) + 1)
+
+/**
+ * Prepares @c dec to decode @c src from the beginning.
+ *
+ * @param dec     decoder to initialize
+ * @param src     encoded stream
+ * @param src_len length of @c src
+ */
+void ssd1306_rle_decoder_init(struct ssd1306_rle_decoder *dec,
+                              const uint8_t *src, size_t src_len);
+
+/**
+ * Decodes up to @c out_len bytes into @c out.
+ *
+ * @param dec         decoder to resume
+ * @param out         buffer to decode into
+ * @param out_len     length of @c out
+ * @param decoded_len set to the number of bytes placed in @c out. Anything less
+ *                    than @c out_len means the stream has ended.
+ *
+ * @return @ref SSD1306_RLE_TRUNCATED if the stream ends in the middle of an
+ *         operation
+ */
+enum ssd1306_err ssd1306_rle_decode(struct ssd1306_rle_decoder *dec,
+                                    uint8_t *out, size_t out_len,
+                                    size_t *decoded_len);
+
+/**
+ * Advances the decoder by @c count decoded bytes without producing them.
+ *
+ * @param dec   decoder to advance
+ * @param count number of decoded bytes to skip
+ *
+ * @return @ref SSD1306_RLE_TRUNCATED if the stream ends before @c count bytes
+ *         were skipped
+ */
+enum ssd1306_err ssd1306_rle_skip(struct ssd1306_rle_decoder *dec,
+                                  size_t count);
+
+/**
+ * Encodes @c src.
+ *
+ * This is meant to be run offline or at start-up, not per frame.
+ *
+ * @param src         data to encode
+ * @param src_len     length of @c src
+ * @param dst         buffer to encode into. Pass in @c NULL to only calculate
+ *                    the encoded length.
+ * @param dst_len     length of @c dst
+ * @param encoded_len set to the length of the encoded stream
+ *
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c dst can't hold the stream
+ */
+enum ssd1306_err ssd1306_rle_encode(const uint8_t *src, size_t src_len,
+                                    uint8_t *dst, size_t dst_len,
+                                    size_t *encoded_len);
+
+/**
+ * Encodes every glyph of @c font into @c dst and fills out @c rle_font.
+ *
+ * @c rle_font points into @c dst and @c block_offsets afterwards, so they must
+ * outlive it.
+ *
+ * @param font             font to encode
+ * @param glyphs_per_block number of glyphs to encode in each block
+ * @param dst              buffer to encode into
+ * @param dst_len          length of @c dst
+ * @param block_offsets    array of
+ *                         @ref SSD1306_RLE_NUM_BLOCK_OFFSETS entries
+ * @param rle_font         compressed font to fill out
+ *
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c dst can't hold the encoded
+ *         glyphs or if they don't fit in 16 bit offsets
+ * @return @ref SSD1306_RLE_NOT_SMALLER if the encoded glyphs and
+ *         @c block_offsets take as many bytes as @c font's glyphs. Try more
+ *         glyphs per block.
+ */
+enum ssd1306_err ssd1306_rle_encode_font(const struct ssd1306_font *font,
+                                         uint8_t glyphs_per_block, uint8_t *dst,
+                                         size_t dst_len,
+                                         uint16_t *block_offsets,
+                                         struct ssd1306_rle_font *rle_font);
+
+/**
+ * Decodes an encoded stream straight into the display's RAM. Like
+ * @ref ssd1306_write_data_list, it addresses the RAM as wired whatever the
+ * rotation.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param rle     encoded stream
+ * @param rle_len length of @c rle
+ *
+ * @return @ref SSD1306_RLE_TRUNCATED if the stream ends in the middle of an
+ *         operation
+ */
+enum ssd1306_err ssd1306_write_rle(struct ssd1306_ctx *ctx, const uint8_t *rle,
+                                   size_t rle_len);
+
+/**
+ * Writes a character from a compressed font to the display.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param font compressed font to look the glyph up in
+ * @param c    character to write to the display
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if @c font has no glyph for @c c
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, like @ref ssd1306_write_char
+ */
+enum ssd1306_err ssd1306_write_rle_char(struct ssd1306_ctx *ctx,
+                                        const struct ssd1306_rle_font *font,
+                                        uint8_t c);
+
+/**
+ * Writes a string from a compressed font to the display.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param font compressed font to look the glyphs up in
+ * @param str  string to write to the display
+ *
+ * @return @ref SSD1306_GLYPH_NOT_IN_FONT if @c font is missing a glyph
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_write_rle_str(struct ssd1306_ctx *ctx,
+                                       const struct ssd1306_rle_font *font,
+                                       const uint8_t *str);
+
+/** @} */ /* rle */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_RLE_H */
@@ -0,0 +1,145 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_SCALE_H
+#define LIBSSD1306_SSD1306_SCALE_H
+
+#include "ssd1306/dither.h"
+#include "ssd1306/err.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup scale Downscaling
+ *
+ * Shrinks 8 bit grayscale images (thumbnails, camera frames, ...) to the
+ * display's resolution and dithers them into a page-major bitmap in a single
+ * pass. Each output row is scaled into a line buffer and handed straight to
+ * a @ref ssd1306_ditherer, so no scaled gray image is ever stored.
+ *
+ * Output pages are independent of each other, so an image can be split into
+ * bands of pages with @ref ssd1306_downscale_pages and each band scaled on a
+ * different thread. When the library is built with pthreads (meson's
+ * @c threads option, which defines @c SSD1306_HAVE_PTHREADS),
+ * @ref ssd1306_downscale_parallel does the splitting. Floyd-Steinberg
+ * diffuses error across bands, so it always runs on a single thread.
+ */
+
+/** @{ */
+
+/**
+ * Widest source image, in pixels, @ref SSD1306_SCALE_BOX can shrink. It sizes
+ * a line of 16 bit sums on the stack.
+ */
+#ifndef SSD1306_SCALE_MAX_SRC_WIDTH
+#define SSD1306_SCALE_MAX_SRC_WIDTH 1024
+#endif
+
+/**
+ * How source pixels are combined into an output pixel.
+ */
+enum ssd1306_scale_filter {
+    /** Take the source pixel closest to the output pixel's center. */
+    SSD1306_SCALE_NEAREST,
+    /** Average every source pixel the output pixel covers. */
+    SSD1306_SCALE_BOX,
+};
+
+/**
+ * Describes a downscaling job.
+ */
+struct ssd1306_downscale {
+    /**
+     * First row of the source image, one byte per pixel. 0 is black and 255
+     * white.
+     */
+    const uint8_t *src;
+    /**
+     * Bytes from one row of the source image to the next.
+     */
+    size_t src_stride;
+    /**
+     * Width of the source image, in pixels.
+     */
+    uint16_t src_width;
+    /**
+     * Height of the source image, in pixels.
+     */
+    uint16_t src_height;
+    /**
+     * Width of the output, in pixels. At most
+     * @ref SSD1306_IMAGE_MAX_WIDTH.
+     */
+    uint16_t width;
+    /**
+     * Height of the output, in pixels.
+     */
+    uint16_t height;
+    /**
+     * How source pixels are combined.
+     */
+    enum ssd1306_scale_filter filter;
+    /**
+     * How gray levels are turned into pixels.
+     */
+    enum ssd1306_dither dither;
+    /**
+     * Output, @ref SSD1306_BITMAP_LEN bytes for @c width by @c height.
+     */
+    uint8_t *dst;
+};
+
+/**
+ * Scales and dithers a whole image.
+ *
+ * @param job what to scale and where to
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if a dimension is 0, the output is
+ *         wider than @ref SSD1306_IMAGE_MAX_WIDTH or the source is wider than
+ *         @ref SSD1306_SCALE_MAX_SRC_WIDTH with @ref SSD1306_SCALE_BOX
+ * @return @ref SSD1306_SCALE_UNSUPPORTED if @ref SSD1306_SCALE_BOX would
+ *         average more than 257 source rows into an output row
+ */
+enum ssd1306_err ssd1306_downscale(const struct ssd1306_downscale *job);
+
+/**
+ * Scales and dithers a band of output pages. Bands that don't overlap can be
+ * scaled at the same time from different threads.
+ *
+ * @param job        what to scale and where to
+ * @param first_page first output page of the band
+ * @param num_pages  number of pages in the band, clipped to the output
+ *
+ * @return see @ref ssd1306_downscale
+ */
+enum ssd1306_err ssd1306_downscale_pages(const struct ssd1306_downscale *job,
+                                         uint16_t first_page,
+                                         uint16_t num_pages);
+
+#if defined(SSD1306_HAVE_PTHREADS)
+/**
+ * Scales and dithers an image, split into @c num_threads bands of pages that
+ * are scaled in parallel. The calling thread scales one of the bands.
+ *
+ * @param job         what to scale and where to
+ * @param num_threads number of threads to use, including the calling one
+ *
+ * @return see @ref ssd1306_downscale
+ */
+enum ssd1306_err ssd1306_downscale_parallel(const struct ssd1306_downscale *job,
+                                            unsigned num_threads);
+#endif
+
+/** @} */ /* scale */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_SCALE_H */
@@ -0,0 +1,121 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_SHADOW_H
+#define LIBSSD1306_SSD1306_SHADOW_H
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/platform.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup shadow Shadow RAM
+ *
+ * A copy of what the display's RAM holds. Flushing a frame against it sends
+ * only the bytes that differ, so callers that redraw whole frames (video,
+ * animations, grayscale bitplanes) don't have to track what they touched.
+ *
+ * Frames and the shadow use the display's page-major layout (see
+ * @ref framebuffer). The differing columns of each page are grouped into
+ * windows the same way @ref ssd1306_fb_flush does, with costs taken from a
+ * @ref ssd1306_bus_model. A flush can be given a time budget: it stops before
+ * the window that would exceed it and the next flush picks up from there.
+ */
+
+/** @{ */
+
+/**
+ * A shadow of the display's RAM. Initialize it with
+ * @ref ssd1306_shadow_init.
+ */
+struct ssd1306_shadow {
+    /**
+     * What the display's RAM holds, @ref SSD1306_FB_LEN bytes.
+     */
+    uint8_t *buf;
+    /**
+     * Width, in columns.
+     */
+    uint16_t width;
+    /**
+     * Height, in rows. Always a multiple of @ref SSD1306_ROWS_PER_PAGE.
+     */
+    uint16_t height;
+    /**
+     * Page of the display's RAM the shadow starts at. It's 0 after
+     * @ref ssd1306_shadow_init; set it to shadow RAM the display isn't
+     * showing, like the back half used by @ref flip.
+     */
+    uint8_t first_page;
+    /**
+     * One bit per page whose contents on the display are unknown. Stale pages
+     * are sent whole.
+     */
+    uint8_t stale;
+};
+
+/**
+ * Sets up a shadow on top of @c buf. Every page starts stale, so the first
+ * flush sends the whole frame.
+ *
+ * @param shadow shadow to initialize
+ * @param buf    storage, @ref SSD1306_FB_LEN bytes
+ * @param width  width of the display's RAM covered, in columns
+ * @param height height of the display's RAM covered, in rows (multiple of 8)
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the dimensions are zero, too big
+ *         for the display's RAM or @c height isn't a multiple of 8
+ */
+enum ssd1306_err ssd1306_shadow_init(struct ssd1306_shadow *shadow,
+                                     uint8_t *buf, uint16_t width,
+                                     uint16_t height);
+
+/**
+ * Marks every page stale. Call it after writing to the display's RAM without
+ * going through the shadow.
+ *
+ * @param shadow shadow to invalidate
+ */
+void ssd1306_shadow_invalidate(struct ssd1306_shadow *shadow);
+
+/**
+ * Sends the bytes of @c frame that differ from the shadow and updates the
+ * shadow. Windows are sent in page order until the next one would take the
+ * total past @c budget_ns. The first window is always sent, so repeated
+ * flushes make progress however small the budget is.
+ *
+ * @param ctx       struct that contains the platform dependent I/O
+ * @param shadow    shadow of the display's RAM
+ * @param frame     frame to display, laid out like @ref ssd1306_shadow::buf
+ * @param bus       bus model that prices windows, or @c NULL to count bytes
+ *                  and ignore @c budget_ns
+ * @param budget_ns time the flush may spend on the bus, in nanoseconds
+ * @param done      set to whether the display now matches @c frame, may be
+ *                  @c NULL
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the shadow is wider than the
+ *         display or runs past the end of its RAM
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, since frames are laid out like the RAM as wired
+ */
+enum ssd1306_err ssd1306_shadow_flush(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_shadow *shadow,
+                                      const uint8_t *frame,
+                                      const struct ssd1306_bus_model *bus,
+                                      uint32_t budget_ns, bool *done);
+
+/** @} */ /* shadow */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_SHADOW_H */
@@ -25,6 +25,11 @@ extern "C" {
  * application note. Refer to the flow chart presented in the figure for the
  * commands/arguments used.
  *
+ * Only @ref ssd1306_ctx::height rows are made active, so the RAM past them
+ * stays off screen. On 128x32 panels, @ref flip uses it as a back buffer.
+ * The common pins are configured to match: alternative for panels taller than
+ * 32 rows, sequential otherwise.
+ *
  * Additionally, this function sets the display in @ref SSD1306_HORIZ_ADDR_MODE,
  * using the entire display as its range.
  *
@@ -34,6 +39,9 @@ extern "C" {
  *
  * @param ctx                  struct that contains the platform dependent I/O
  * @param should_clear_display flag to clear the RAM of the display
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if @ref ssd1306_ctx::height is
+ *         greater than 64
  */
 enum ssd1306_err ssd1306_init_display(struct ssd1306_ctx *ctx,
                                       bool should_clear_display);
@@ -484,6 +492,40 @@ enum ssd1306_err ssd1306_set_vert_scroll_area(struct ssd1306_ctx *ctx,
                                               enum ssd1306_row static_rows,
                                               enum ssd1306_row dynamic_rows);
 
+/**
+ * Stops scrolling so the display's RAM can be written, if the scroll was
+ * started through this library. Does nothing otherwise.
+ *
+ * @see ssd1306_resume_scrolling
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ */
+enum ssd1306_err ssd1306_pause_scrolling(struct ssd1306_ctx *ctx);
+
+/**
+ * Restarts a scroll stopped by @ref ssd1306_pause_scrolling. The scroll setup
+ * remembered in @ref ssd1306_ctx::scroll and @ref SSD1306_START_SCROLLING are
+ * sent as one command list. Does nothing if the scroll isn't paused.
+ *
+ * The flushes pause and resume scrolling around their writes on their own.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ */
+enum ssd1306_err ssd1306_resume_scrolling(struct ssd1306_ctx *ctx);
+
+/**
+ * Counts the steps the display has scrolled since
+ * @ref ssd1306_start_scrolling, through every pause and resume in between.
+ *
+ * The steps are timed with @ref ssd1306_scroll::clock. Without one, no steps
+ * are counted.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ *
+ * @return the number of steps, 0 if @c ctx is @c NULL
+ */
+uint32_t ssd1306_scroll_steps(const struct ssd1306_ctx *ctx);
+
 /** @} */ /* scrolling_commands */
 
 /**
@@ -939,6 +981,30 @@ ssd1306_set_common_pin_config(struct ssd1306_ctx *ctx,
                               enum ssd1306_common_pin_config common_layout,
                               enum ssd1306_common_pin_config left_right_remap);
 
+/**
+ * Sets how the panel is mounted and records it in
+ * @ref ssd1306_ctx::rotation. Every rotation is done with the segment remap
+ * and the COM scan direction: 0 and 180 degrees need nothing else, 90 and 270
+ * degrees also need the picture transposed, which @ref ssd1306_fb_flush does
+ * for framebuffers as tall as the display is wide.
+ *
+ * Like the reflections, the segment remap only applies to data written
+ * afterwards, so redraw the whole display after changing the rotation.
+ *
+ * @param ctx      struct that contains the platform dependent I/O
+ * @param rotation clockwise rotation of the picture
+ */
+enum ssd1306_err ssd1306_set_rotation(struct ssd1306_ctx *ctx,
+                                      enum ssd1306_rotation rotation);
+
+/**
+ * Checks whether the display is rotated a quarter turn, so that it's as wide
+ * as its RAM is tall.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ */
+bool ssd1306_is_portrait(const struct ssd1306_ctx *ctx);
+
 /** @} */ /* hardware_configuration_commands */
 
 /**
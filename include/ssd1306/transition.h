@@ -0,0 +1,164 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_TRANSITION_H
+#define LIBSSD1306_SSD1306_TRANSITION_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup transition Screen Transitions
+ *
+ * Animates the change from one full screen framebuffer to another without
+ * redrawing either. Each tick sends only the rows or columns of the incoming
+ * screen that come into view, never more than a budget of bytes, and lets the
+ * display's own registers move the rest.
+ *
+ * - Slides move both screens up or down with the start line. The incoming
+ *   screen is written to the rows that scroll in: on a 64 row display they're
+ *   the rows that just scrolled out, merged with the outgoing screen's rows
+ *   still in view. On displays of 32 rows or less the incoming screen goes to
+ *   the RAM the display doesn't show, ahead of time when the budget allows,
+ *   and is copied back behind the scenes at the end so the start line returns
+ *   to 0.
+ * - Wipes uncover the incoming screen column after column.
+ * - Pushes move both screens sideways with the horizontal scroll. The display
+ *   wraps the columns it scrolls out around to the other edge and each tick
+ *   overwrites them with the incoming screen's next columns, like a
+ *   @ref marquee.
+ *
+ * Transitions start from the outgoing screen in RAM as the flushes leave it,
+ * at start line 0, and end with the incoming screen the same way.
+ */
+
+/** @{ */
+
+/**
+ * How a transition moves. Directions are those of the outgoing screen, or of
+ * the edge between the screens for wipes.
+ */
+enum ssd1306_transition_effect {
+    SSD1306_TRANSITION_SLIDE_UP,   /**< Start line, in from the bottom. */
+    SSD1306_TRANSITION_SLIDE_DOWN, /**< Start line, in from the top. */
+    SSD1306_TRANSITION_WIPE_LEFT,  /**< Columns, right to left. */
+    SSD1306_TRANSITION_WIPE_RIGHT, /**< Columns, left to right. */
+    SSD1306_TRANSITION_PUSH_LEFT,  /**< Horizontal scroll, in from the right. */
+    SSD1306_TRANSITION_PUSH_RIGHT, /**< Horizontal scroll, in from the left. */
+};
+
+/**
+ * A transition. Start it with @ref ssd1306_transition_start.
+ */
+struct ssd1306_transition {
+    /**
+     * Outgoing screen, @ref SSD1306_FB_LEN bytes for the display.
+     */
+    const uint8_t *from;
+    /**
+     * Incoming screen, @ref SSD1306_FB_LEN bytes for the display.
+     */
+    const uint8_t *to;
+    /**
+     * A @ref ssd1306_transition_effect.
+     */
+    uint8_t effect;
+    /**
+     * Rows or columns moved each tick by slides and wipes.
+     */
+    uint8_t step;
+    /**
+     * Most bytes, commands and data, sent by a tick.
+     */
+    uint16_t budget;
+    /**
+     * Rows or columns the transition has moved. Slides on displays of 32 rows
+     * or less go on counting the pages copied back once every row has moved.
+     */
+    uint8_t pos;
+    /**
+     * Columns a push has scrolled out and not overwritten yet. The scroll is
+     * paused until they are.
+     */
+    uint8_t pending;
+    /**
+     * Rows of each page of RAM that hold the incoming screen during a slide.
+     */
+    uint8_t fresh[SSD1306_FB_MAX_PAGES];
+    /**
+     * Clock used to count scroll steps, @c NULL unless pushing.
+     */
+    const struct ssd1306_frame_clock *clock;
+    /**
+     * Frames between scroll steps.
+     */
+    enum ssd1306_scroll_step interval;
+    /**
+     * Time the scroll was last started at.
+     */
+    uint64_t start_ns;
+};
+
+/**
+ * Starts a transition. Pushes start scrolling right away, the other effects
+ * send nothing until the first tick.
+ *
+ * @param ctx        struct that contains the platform dependent I/O
+ * @param transition transition to start
+ * @param effect     how the screens move
+ * @param from       outgoing screen, currently on the display
+ * @param to         incoming screen
+ * @param step       rows or columns to move each tick, for slides and wipes
+ * @param budget     most bytes to send each tick. Every tick moves at least a
+ *                   row or column, whatever it costs.
+ * @param clock      clock locked to the display, only used when pushing
+ * @param interval   frames between scroll steps, only used when pushing
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if @c step is 0 or the display is
+ *         wider than its RAM. Slides also need a display of 64 rows or of
+ *         32 rows or less.
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn. The screens are laid out like the RAM as wired.
+ */
+enum ssd1306_err
+ssd1306_transition_start(struct ssd1306_ctx *ctx,
+                         struct ssd1306_transition *transition,
+                         enum ssd1306_transition_effect effect,
+                         const uint8_t *from, const uint8_t *to, uint8_t step,
+                         uint16_t budget,
+                         const struct ssd1306_frame_clock *clock,
+                         enum ssd1306_scroll_step interval);
+
+/**
+ * Moves a transition on by a frame. Call it once per frame until @c done is
+ * set.
+ *
+ * @param ctx        struct that contains the platform dependent I/O
+ * @param transition transition to move on
+ * @param done       set to whether the incoming screen is fully shown
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_transition_tick(struct ssd1306_ctx *ctx,
+                                         struct ssd1306_transition *transition,
+                                         bool *done);
+
+/** @} */ /* transition */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_TRANSITION_H */
@@ -0,0 +1,93 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_TRANSPOSE_H
+#define LIBSSD1306_SSD1306_TRANSPOSE_H
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup transpose Transpose
+ *
+ * Converts row-major 1bpp images (XBM, PBM, camera frames, ...) to the
+ * page-major layout of the display's RAM.
+ *
+ * A row-major byte holds 8 pixels of a row while a page-major byte holds 8
+ * pixels of a column, so converting between the two is an 8x8 bit matrix
+ * transpose for each 8x8 block of pixels. Blocks are transposed with three
+ * delta swaps on a 64 bit word instead of moving one bit at a time. When the
+ * target has SSE2 or NEON, @ref ssd1306_transpose_8x8_batch transposes two
+ * blocks per instruction. Define @c SSD1306_NO_SIMD to always use the
+ * portable code.
+ */
+
+/** @{ */
+
+/**
+ * Order of the pixels within a byte of a row-major image.
+ */
+enum ssd1306_bit_order {
+    /** The least significant bit is the left most pixel (XBM). */
+    SSD1306_LSB_FIRST,
+    /** The most significant bit is the left most pixel (PBM). */
+    SSD1306_MSB_FIRST,
+};
+
+/**
+ * Transposes an 8x8 bit matrix.
+ *
+ * Bit @c c of @c in[r] becomes bit @c r of @c out[c]. With @c in being 8 rows
+ * of 8 pixels in @ref SSD1306_LSB_FIRST order, @c out is the 8 columns of a
+ * page. Transposing twice gives back the original matrix.
+ *
+ * @param in  8 rows
+ * @param out 8 columns, can be the same as @c in
+ */
+void ssd1306_transpose_8x8(const uint8_t *in, uint8_t *out);
+
+/**
+ * Transposes @c num_blocks 8x8 bit matrices stored back to back, 8 bytes each.
+ *
+ * @see ssd1306_transpose_8x8
+ *
+ * @param in         @c num_blocks * 8 bytes of rows
+ * @param out        @c num_blocks * 8 bytes of columns, can be the same as
+ *                   @c in
+ * @param num_blocks number of matrices to transpose
+ */
+void ssd1306_transpose_8x8_batch(const uint8_t *in, uint8_t *out,
+                                 size_t num_blocks);
+
+/**
+ * Converts a row-major 1bpp image to the page-major layout of
+ * @ref ssd1306_bitmap.
+ *
+ * Row @c r of the image starts at @c src[r * src_stride]. The output is
+ * @c width columns by @c (height + 7) / 8 pages: byte
+ * @c dst[page * width + x] holds rows @c page * 8 to @c page * 8 + 7 of
+ * column @c x. Rows past @c height in the last page are zero.
+ *
+ * @param src        first row of the image
+ * @param src_stride bytes from one row of the image to the next
+ * @param width      width of the image, in pixels
+ * @param height     height of the image, in pixels
+ * @param order      order of the pixels within the image's bytes
+ * @param dst        @ref SSD1306_BITMAP_LEN bytes for the converted image
+ */
+void ssd1306_rows_to_pages(const uint8_t *src, size_t src_stride,
+                           uint16_t width, uint16_t height,
+                           enum ssd1306_bit_order order, uint8_t *dst);
+
+/** @} */ /* transpose */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_TRANSPOSE_H */
@@ -0,0 +1,136 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_VIEWPORT_H
+#define LIBSSD1306_SSD1306_VIEWPORT_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/shadow.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup viewport Viewport
+ *
+ * A window the size of the display onto a page-major image bigger than the
+ * display, a map or a long menu for instance. The image is only read, never
+ * copied, so it can live in flash or in a file mapped with @c mmap.
+ *
+ * The display's 64 rows of RAM are used as a ring: row @c v of the image is
+ * kept in RAM row @c (v - phase) % 64 and the start line register picks the
+ * row shown at the top. Panning vertically moves the start line and only the
+ * pages of the image that weren't in RAM yet are sent. The SSD1306 has no
+ * column offset, so horizontal pans shift every column: each pan is diffed
+ * against a @ref shadow of the RAM and only the bytes that changed are sent,
+ * which on sparse images like menus is much less than the whole screen.
+ *
+ * Changes to the image are picked up the same way: show the same position
+ * again and whatever differs is sent.
+ *
+ * The viewport owns the display's RAM and start line.
+ */
+
+/** @{ */
+
+/**
+ * Calculates the number of bytes of scratch memory a viewport needs: a shadow
+ * of the display's RAM and the frame built for each pan.
+ *
+ * @param width width of the display, in columns
+ */
+#define SSD1306_VIEWPORT_LEN(width)                                            \
+    (2 * SSD1306_FB_LEN(width, SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE))
+
+/**
+ * A viewport. Initialize it with @ref ssd1306_viewport_init.
+ */
+struct ssd1306_viewport {
+    /**
+     * Image shown, page-major, with @c image_width bytes per page.
+     */
+    const uint8_t *image;
+    /**
+     * Width of the image, in columns.
+     */
+    uint16_t image_width;
+    /**
+     * Height of the image, in rows. Always a multiple of
+     * @ref SSD1306_ROWS_PER_PAGE.
+     */
+    uint16_t image_height;
+    /**
+     * Column of the image at the left edge of the display.
+     */
+    uint16_t x;
+    /**
+     * Row of the image at the top of the display.
+     */
+    uint16_t y;
+    /**
+     * Rows between the start of the image's pages and the start of the
+     * display's pages. Only 64 row displays need one, when they show rows
+     * that straddle 9 pages of the image.
+     */
+    uint8_t phase;
+    /**
+     * What the display's RAM holds.
+     */
+    struct ssd1306_shadow shadow;
+    /**
+     * Frame the display's RAM is diffed against, built for each pan.
+     */
+    uint8_t *frame;
+};
+
+/**
+ * Sets up a viewport at the top left corner of an image. Nothing is sent
+ * until @ref ssd1306_viewport_show.
+ *
+ * @param ctx          struct that contains the platform dependent I/O
+ * @param viewport     viewport to initialize
+ * @param buf          scratch memory, @ref SSD1306_VIEWPORT_LEN bytes
+ * @param image        image to show, page-major
+ * @param image_width  width of the image, in columns
+ * @param image_height height of the image, in rows (multiple of 8)
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the display is wider than its RAM
+ *         or @c image_height isn't a multiple of 8
+ */
+enum ssd1306_err ssd1306_viewport_init(struct ssd1306_ctx *ctx,
+                                       struct ssd1306_viewport *viewport,
+                                       uint8_t *buf, const uint8_t *image,
+                                       uint16_t image_width,
+                                       uint16_t image_height);
+
+/**
+ * Shows the part of the image whose top left corner is at @c x, @c y. Parts
+ * of the display past the image's edges are blank.
+ *
+ * @param ctx      struct that contains the platform dependent I/O
+ * @param viewport viewport to move
+ * @param x        column of the image at the left edge of the display
+ * @param y        row of the image at the top of the display
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn. The start line only pans the display's own rows.
+ * @return see @ref ssd1306_shadow_flush
+ */
+enum ssd1306_err ssd1306_viewport_show(struct ssd1306_ctx *ctx,
+                                       struct ssd1306_viewport *viewport,
+                                       uint16_t x, uint16_t y);
+
+/** @} */ /* viewport */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_VIEWPORT_H */
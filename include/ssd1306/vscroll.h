@@ -0,0 +1,180 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_VSCROLL_H
+#define LIBSSD1306_SSD1306_VSCROLL_H
+
+#include "ssd1306/err.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup vscroll Vertical Scrolling
+ *
+ * A fixed header above a body that scrolls vertically in hardware. The header
+ * is the display's top pages, made static with
+ * @ref ssd1306_set_vert_scroll_area. The rest of the display is the body, a
+ * ring of lines that @ref ssd1306_scroll_vert_right or
+ * @ref ssd1306_scroll_vert_left moves up by a few rows every few frames. While
+ * it scrolls, nothing is sent to the display.
+ *
+ * Content is a list of 8 row lines, numbered from 0. Starting the scroll at
+ * line @c base shows lines @c base to @c base + body pages - 1, which have to
+ * be written first, to the pages @ref ssd1306_vscroll_page gives for that
+ * @c base. A frame clock
+ * tracks which of the list's rows are at the top of the body, see
+ * @ref ssd1306_vscroll_first_row. Once the body has scrolled through what was
+ * written, stop, write the next lines and start again from a later @c base.
+ *
+ * @note The SSD1306 has no vertical only scroll: the same commands also
+ *       scroll the columns of a range of pages horizontally. The scroll keeps
+ *       that range to a single page, given at init. Use a page whose content
+ *       doesn't mind moving sideways, for instance a blank one.
+ */
+
+/** @{ */
+
+/**
+ * A header and a scrolling body. Initialize it with
+ * @ref ssd1306_vscroll_init.
+ */
+struct ssd1306_vscroll {
+    /**
+     * Clock used to tell how far the body has scrolled.
+     */
+    const struct ssd1306_frame_clock *clock;
+    /**
+     * Pages in the header.
+     */
+    uint8_t header_pages;
+    /**
+     * Pages in the body.
+     */
+    uint8_t body_pages;
+    /**
+     * Page the horizontal part of the scroll runs in.
+     */
+    enum ssd1306_page horiz_page;
+    /**
+     * Frames between scroll steps.
+     */
+    enum ssd1306_scroll_step interval;
+    /**
+     * Rows the body moves up by each step.
+     */
+    uint8_t step_rows;
+    /**
+     * Whether the horizontal part of the scroll goes left.
+     */
+    bool left;
+    /**
+     * Whether the body is scrolling.
+     */
+    bool running;
+    /**
+     * Line shown at the top of the body when the scroll started.
+     */
+    uint16_t base_line;
+    /**
+     * Time the scroll started at.
+     */
+    uint64_t start_ns;
+};
+
+/**
+ * Makes the top @c header_pages of the display static and sets up how the
+ * body scrolls. Nothing scrolls until @ref ssd1306_vscroll_start.
+ *
+ * @param ctx          struct that contains the platform dependent I/O
+ * @param vscroll      layout to initialize
+ * @param clock        clock locked to the display
+ * @param header_pages pages in the header
+ * @param interval     frames between scroll steps
+ * @param step_rows    rows the body moves up by each step
+ * @param horiz_page   page the horizontal part of the scroll runs in
+ * @param left         whether that page moves left instead of right
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the header leaves no body or
+ *         @c step_rows isn't smaller than the body
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn, which would scroll the body sideways
+ */
+enum ssd1306_err ssd1306_vscroll_init(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_vscroll *vscroll,
+                                      const struct ssd1306_frame_clock *clock,
+                                      uint8_t header_pages,
+                                      enum ssd1306_scroll_step interval,
+                                      uint8_t step_rows,
+                                      enum ssd1306_page horiz_page,
+                                      bool left);
+
+/**
+ * Finds the page of the display's RAM a line of the body is written to, for
+ * a scroll that @ref ssd1306_vscroll_start will start at @c base_line.
+ *
+ * The lines are written while the scroll is stopped, before it starts, so
+ * the base is passed in rather than read from @c vscroll.
+ *
+ * @param vscroll   layout the line belongs to
+ * @param base_line line the scroll will start at
+ * @param line      line of the list, from @c base_line onwards
+ *
+ * @return the page
+ */
+enum ssd1306_page ssd1306_vscroll_page(const struct ssd1306_vscroll *vscroll,
+                                       uint16_t base_line, uint16_t line);
+
+/**
+ * Starts scrolling the body with line @c base_line at its top. Lines
+ * @c base_line onwards must already be in the pages
+ * @ref ssd1306_vscroll_page gives for them with the same @c base_line.
+ *
+ * @param ctx       struct that contains the platform dependent I/O
+ * @param vscroll   layout to scroll
+ * @param base_line line at the top of the body
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn
+ */
+enum ssd1306_err ssd1306_vscroll_start(struct ssd1306_ctx *ctx,
+                                       struct ssd1306_vscroll *vscroll,
+                                       uint16_t base_line);
+
+/**
+ * Stops scrolling, so the body can be written to.
+ *
+ * @param ctx     struct that contains the platform dependent I/O
+ * @param vscroll layout to stop
+ */
+enum ssd1306_err ssd1306_vscroll_stop(struct ssd1306_ctx *ctx,
+                                      struct ssd1306_vscroll *vscroll);
+
+/**
+ * Finds the row of the list at the top of the body. Rows past
+ * @c base_line * 8 + body rows have wrapped around to content written before
+ * the scroll started.
+ *
+ * @param vscroll layout to read
+ * @param now_ns  current time, from the clock's time source
+ *
+ * @return the row, counting 8 per line
+ */
+uint32_t ssd1306_vscroll_first_row(const struct ssd1306_vscroll *vscroll,
+                                   uint64_t now_ns);
+
+/** @} */ /* vscroll */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_VSCROLL_H */
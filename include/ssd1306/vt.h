@@ -0,0 +1,161 @@
+/**
+ * @file
+ */
+
+#ifndef LIBSSD1306_SSD1306_VT_H
+#define LIBSSD1306_SSD1306_VT_H
+
+#include "ssd1306/console.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup vt VT100 Terminal
+ *
+ * A terminal on top of a @ref console that understands the subset of VT100
+ * escape sequences programs use to format their output:
+ *
+ * - @c CR, @c LF, @c BS and @c TAB
+ * - @c ESC[row;colH and @c ESC[row;colf, cursor position
+ * - @c ESC[nA, @c ESC[nB, @c ESC[nC and @c ESC[nD, cursor movement
+ * - @c ESC[nJ and @c ESC[nK, erase in screen and erase in line
+ * - @c ESC[7m, @c ESC[27m and @c ESC[0m, reverse video on and off
+ *
+ * Other sequences are parsed and ignored. @c LF also returns the carriage,
+ * like a tty with @c onlcr. Text wraps at the right edge and scrolls at the
+ * bottom, in hardware.
+ *
+ * The terminal keeps a copy of the characters on screen and marks a cell
+ * dirty only when its character or attributes change. @ref ssd1306_vt_feed
+ * parses any chunk of bytes, down to one at a time, and then redraws the dirty
+ * cells, so rewriting a status line with the same text costs nothing.
+ */
+
+/** @{ */
+
+#ifndef SSD1306_VT_MAX_COLS
+/**
+ * Most characters per line. Fonts narrower than @c 128 / this aren't
+ * supported.
+ */
+#define SSD1306_VT_MAX_COLS 32
+#endif
+
+#ifndef SSD1306_VT_MAX_PARAMS
+/**
+ * Most parameters kept from an escape sequence. Extra ones are ignored.
+ */
+#define SSD1306_VT_MAX_PARAMS 4
+#endif
+
+/**
+ * Cell attributes.
+ */
+enum ssd1306_vt_attr {
+    SSD1306_VT_ATTR_REVERSE = 1, /**< Draw the cell inverted. */
+};
+
+/**
+ * Where the parser is in an escape sequence.
+ */
+enum ssd1306_vt_state {
+    SSD1306_VT_GROUND, /**< Printing text. */
+    SSD1306_VT_ESCAPE, /**< After an @c ESC. */
+    SSD1306_VT_CSI,    /**< In an @c ESC[ sequence. */
+};
+
+/**
+ * A terminal. Initialize it with @ref ssd1306_vt_init.
+ */
+struct ssd1306_vt {
+    /**
+     * Console the terminal draws through.
+     */
+    struct ssd1306_console console;
+    /**
+     * Characters, by line of the console's ring.
+     */
+    uint8_t chars[SSD1306_FB_MAX_PAGES][SSD1306_VT_MAX_COLS];
+    /**
+     * Attributes, from @ref ssd1306_vt_attr, by line of the console's ring.
+     */
+    uint8_t attrs[SSD1306_FB_MAX_PAGES][SSD1306_VT_MAX_COLS];
+    /**
+     * First dirty column of each line of the ring.
+     */
+    uint8_t dirty_first[SSD1306_FB_MAX_PAGES];
+    /**
+     * Last dirty column of each line of the ring. A line is clean when it's
+     * before @c dirty_first.
+     */
+    uint8_t dirty_last[SSD1306_FB_MAX_PAGES];
+    /**
+     * Attributes new characters get.
+     */
+    uint8_t attr;
+    /**
+     * Parser state, from @ref ssd1306_vt_state.
+     */
+    uint8_t state;
+    /**
+     * Whether the sequence being parsed has a private marker such as @c ?.
+     * Such sequences are ignored.
+     */
+    bool private_seq;
+    /**
+     * Number of parameters parsed, including the one being parsed.
+     */
+    uint8_t num_params;
+    /**
+     * Parameters of the sequence being parsed.
+     */
+    uint16_t params[SSD1306_VT_MAX_PARAMS];
+};
+
+/**
+ * Sets up the console, clears the screen and resets the parser.
+ *
+ * @param ctx struct that contains the platform dependent I/O
+ * @param vt  terminal to initialize
+ *
+ * @return @ref SSD1306_OUT_OF_DIMENSION if the console can't be set up or has
+ *         more than @ref SSD1306_VT_MAX_COLS columns
+ * @return the errors of @ref ssd1306_console_init
+ */
+enum ssd1306_err ssd1306_vt_init(struct ssd1306_ctx *ctx,
+                                 struct ssd1306_vt *vt);
+
+/**
+ * Parses bytes of output and redraws the cells they changed. Sequences may
+ * be split across calls.
+ *
+ * Bytes the console's font has no glyph for are shown as @c '?'.
+ *
+ * @param ctx  struct that contains the platform dependent I/O
+ * @param vt   terminal to write to
+ * @param data bytes to parse
+ * @param len  length of @c data
+ *
+ * @return @ref SSD1306_ROTATION_UNSUPPORTED if the display is rotated a
+ *         quarter turn. Nothing is parsed.
+ */
+enum ssd1306_err ssd1306_vt_feed(struct ssd1306_ctx *ctx,
+                                 struct ssd1306_vt *vt, const uint8_t *data,
+                                 size_t len);
+
+/** @} */ /* vt */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBSSD1306_SSD1306_VT_H */
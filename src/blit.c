@@ -0,0 +1,192 @@
+#include "ssd1306/blit.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/ssd1306.h"
+
+#include "page.h"
+
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memcpy */
+
+/**
+ * Number of columns combined at once. Each column is a byte lane of a
+ * @c uint32_t.
+ */
+#define LANES 4
+
+/**
+ * Copies @c byte into every lane of a word.
+ */
+#define BROADCAST(byte) ((uint32_t)(byte) * UINT32_C(0x01010101))
+
+/**
+ * Loads up to @ref LANES bytes into a word. Lanes past @c len are zero.
+ *
+ * Every operation done on a loaded word is lane-wise, so the byte order of the
+ * word doesn't matter as long as it's stored back with @ref store. Whole words
+ * are copied with a constant size so compilers turn them into a single move.
+ */
+static uint32_t
+load(const uint8_t *bytes, size_t len)
+{
+    uint32_t word = 0;
+
+    if (len == LANES) {
+        memcpy(&word, bytes, LANES);
+    }
+    else {
+        memcpy(&word, bytes, len);
+    }
+
+    return word;
+}
+
+static void
+store(uint8_t *bytes, uint32_t word, size_t len)
+{
+    if (len == LANES) {
+        memcpy(bytes, &word, LANES);
+    }
+    else {
+        memcpy(bytes, &word, len);
+    }
+}
+
+/**
+ * Combines a word of the framebuffer with a word of the bitmap.
+ *
+ * @param dst  word of the framebuffer
+ * @param src  word of the bitmap, already aligned to the framebuffer's rows
+ *             and masked with @c mask
+ * @param mask rows of each lane the blit covers
+ * @param rop  raster operation
+ */
+static uint32_t
+combine(uint32_t dst, uint32_t src, uint32_t mask, enum ssd1306_rop rop)
+{
+    switch (rop) {
+        case SSD1306_ROP_COPY:
+            return (dst & ~mask) | src;
+        case SSD1306_ROP_SET:
+            return dst | src;
+        case SSD1306_ROP_CLEAR:
+            return dst & ~src;
+        case SSD1306_ROP_XOR:
+            return dst ^ src;
+        case SSD1306_ROP_AND:
+            return dst & (src | ~mask);
+        default: /* SSD1306_ROP_COPY_NOT */
+            return (dst & ~mask) | (~src & mask);
+    }
+}
+
+/**
+ * Blits one page worth of columns.
+ *
+ * Each framebuffer byte is made of the bitmap page that lands on it, shifted
+ * down by @c shift rows, and the bottom of the bitmap page above it.
+ *
+ * @param dst       first byte of the framebuffer to change
+ * @param src       first byte of the bitmap page that lands on @c dst or
+ *                  @c NULL if it's past the bitmap's bottom
+ * @param src_above first byte of the bitmap page above @c src or @c NULL when
+ *                  there's none or @c shift is 0
+ * @param len       number of columns
+ * @param shift     number of rows the bitmap is shifted down
+ * @param mask      rows of the page the blit covers
+ * @param rop       raster operation
+ */
+static void
+blit_page(uint8_t *dst, const uint8_t *src, const uint8_t *src_above,
+          size_t len, unsigned shift, uint8_t mask, enum ssd1306_rop rop)
+{
+    uint32_t lane_mask = BROADCAST(mask);
+    /* Drop the bits a shift carries over from the neighbouring lane. */
+    uint32_t src_keep = BROADCAST((uint8_t)(0xFFU << shift));
+    uint32_t above_keep = BROADCAST((uint8_t)(0xFFU >> (8 - shift)));
+
+    for (size_t i = 0; i < len; i += LANES) {
+        size_t n = len - i < LANES ? len - i : LANES;
+        uint32_t bits = 0;
+
+        if (src != NULL) {
+            bits = (load(&src[i], n) << shift) & src_keep;
+        }
+
+        if (src_above != NULL) {
+            bits |= (load(&src_above[i], n) >> (8 - shift)) & above_keep;
+        }
+
+        uint32_t combined =
+            combine(load(&dst[i], n), bits & lane_mask, lane_mask, rop);
+
+        store(&dst[i], combined, n);
+    }
+}
+
+enum ssd1306_err
+ssd1306_fb_blit(struct ssd1306_fb *fb, const struct ssd1306_bitmap *bitmap,
+                int16_t x, int16_t y, uint16_t w, uint16_t h,
+                enum ssd1306_rop rop)
+{
+    if (bitmap == NULL || bitmap->data == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    if (w > bitmap->width) {
+        w = bitmap->width;
+    }
+
+    if (h > bitmap->height) {
+        h = bitmap->height;
+    }
+
+    /* Clip to the framebuffer. End coordinates are exclusive. */
+    long first_x = x < 0 ? 0 : x;
+    long end_x = (long)x + w < fb->width ? (long)x + w : fb->width;
+    long first_y = y < 0 ? 0 : y;
+    long end_y = (long)y + h < fb->height ? (long)y + h : fb->height;
+
+    if (first_x >= end_x || first_y >= end_y) {
+        return SSD1306_OK;
+    }
+
+    size_t cols = (size_t)(end_x - first_x);
+    size_t src_col = (size_t)(first_x - x);
+    long src_pages = (bitmap->height + SSD1306_ROWS_PER_PAGE - 1)
+                     / SSD1306_ROWS_PER_PAGE;
+    long top_page = ssd1306_page_of_row(y);
+    unsigned shift = (unsigned)(y - top_page * SSD1306_ROWS_PER_PAGE);
+
+    for (long page = first_y / SSD1306_ROWS_PER_PAGE;
+         page <= (end_y - 1) / SSD1306_ROWS_PER_PAGE; page++) {
+        uint8_t mask =
+            ssd1306_page_bits((int)page, (int)first_y, (int)(end_y - 1));
+        long src_page = page - top_page;
+        const uint8_t *src = NULL;
+        const uint8_t *src_above = NULL;
+        uint8_t *dst = &fb->buf[page * fb->width + first_x];
+
+        if (src_page < src_pages) {
+            src = &bitmap->data[src_page * bitmap->width + src_col];
+        }
+
+        if (shift != 0 && src_page > 0) {
+            src_above = &bitmap->data[(src_page - 1) * bitmap->width + src_col];
+        }
+
+        if (rop == SSD1306_ROP_COPY && shift == 0 && mask == 0xFF) {
+            memcpy(dst, src, cols);
+        }
+        else {
+            blit_page(dst, src, src_above, cols, shift, mask, rop);
+        }
+    }
+
+    ssd1306_fb_mark_dirty(fb, (int16_t)first_x, (int16_t)first_y,
+                          (int16_t)cols, (int16_t)(end_y - first_y));
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,64 @@
+#include "ssd1306/bus.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+
+/**
+ * Clocks per byte on I2C: 8 bits and the ACK.
+ */
+#define I2C_BYTE_CLOCKS 9
+
+/**
+ * Clocks of overhead per I2C transaction: the start condition, the address
+ * and control bytes with their ACKs, and the stop condition.
+ */
+#define I2C_TRANSACTION_CLOCKS 20
+
+/**
+ * Clocks per byte on SPI.
+ */
+#define SPI_BYTE_CLOCKS 8
+
+static uint32_t
+clocks_to_ns(uint32_t clocks, uint32_t clock_hz)
+{
+    if (clock_hz == 0) {
+        return UINT32_MAX;
+    }
+
+    return (uint32_t)(((uint64_t)clocks * 1000000000U + clock_hz - 1)
+                      / clock_hz);
+}
+
+static uint32_t
+saturate(uint64_t ns)
+{
+    return ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+void
+ssd1306_bus_model_i2c(struct ssd1306_bus_model *bus, uint32_t clock_hz)
+{
+    bus->byte_ns = clocks_to_ns(I2C_BYTE_CLOCKS, clock_hz);
+    bus->transaction_ns = clocks_to_ns(I2C_TRANSACTION_CLOCKS, clock_hz);
+}
+
+void
+ssd1306_bus_model_spi(struct ssd1306_bus_model *bus, uint32_t clock_hz)
+{
+    bus->byte_ns = clocks_to_ns(SPI_BYTE_CLOCKS, clock_hz);
+    bus->transaction_ns = 0;
+}
+
+uint32_t
+ssd1306_bus_cmd_ns(const struct ssd1306_bus_model *bus, size_t len)
+{
+    return saturate((uint64_t)len * ((uint64_t)bus->transaction_ns
+                                     + bus->byte_ns));
+}
+
+uint32_t
+ssd1306_bus_data_ns(const struct ssd1306_bus_model *bus, size_t len)
+{
+    return saturate(bus->transaction_ns + (uint64_t)len * bus->byte_ns);
+}
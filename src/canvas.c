@@ -0,0 +1,300 @@
+#include "ssd1306/canvas.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+#include "ssd1306/transpose.h"
+
+#include "window.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memset */
+
+static uint8_t
+num_bands(const struct ssd1306_canvas *canvas)
+{
+    return canvas->height / SSD1306_ROWS_PER_PAGE;
+}
+
+/**
+ * Returns the dirty tracker of @c canvas. Its pages are the bands.
+ */
+static struct ssd1306_spans
+dirty_spans(struct ssd1306_canvas *canvas)
+{
+    return (struct ssd1306_spans){
+        .first = canvas->dirty_first,
+        .last = canvas->dirty_last,
+        .num_pages = num_bands(canvas),
+        .width = canvas->width,
+        .col_bytes = 1,
+    };
+}
+
+enum ssd1306_err
+ssd1306_canvas_init(struct ssd1306_canvas *canvas, uint8_t *buf,
+                    uint16_t width, uint16_t height)
+{
+    if (canvas == NULL || buf == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (width == 0 || width > SSD1306_FB_MAX_WIDTH || height == 0
+             || height > SSD1306_FB_MAX_HEIGHT
+             || height % SSD1306_ROWS_PER_PAGE != 0) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    canvas->buf = buf;
+    canvas->stride = SSD1306_CANVAS_STRIDE(width);
+    canvas->width = width;
+    canvas->height = height;
+
+    ssd1306_canvas_clear(canvas);
+
+    return SSD1306_OK;
+}
+
+void
+ssd1306_canvas_clear(struct ssd1306_canvas *canvas)
+{
+    memset(canvas->buf, 0x00, canvas->stride * canvas->height);
+
+    ssd1306_canvas_mark_all_dirty(canvas);
+}
+
+void
+ssd1306_canvas_mark_dirty(struct ssd1306_canvas *canvas, int16_t x, int16_t y,
+                          int16_t w, int16_t h)
+{
+    const struct ssd1306_spans spans = dirty_spans(canvas);
+
+    ssd1306_spans_mark_dirty(&spans, x, y, w, h);
+}
+
+void
+ssd1306_canvas_mark_all_dirty(struct ssd1306_canvas *canvas)
+{
+    const struct ssd1306_spans spans = dirty_spans(canvas);
+
+    ssd1306_spans_mark_all_dirty(&spans);
+}
+
+void
+ssd1306_canvas_mark_clean(struct ssd1306_canvas *canvas)
+{
+    const struct ssd1306_spans spans = dirty_spans(canvas);
+
+    ssd1306_spans_mark_clean(&spans);
+}
+
+void
+ssd1306_canvas_set_pixel(struct ssd1306_canvas *canvas, int16_t x, int16_t y,
+                         enum ssd1306_color color)
+{
+    if (x < 0 || x >= canvas->width || y < 0 || y >= canvas->height) {
+        return;
+    }
+
+    uint8_t *byte = &canvas->buf[y * canvas->stride + x / 8];
+    uint8_t bit = 1U << (x % 8);
+
+    switch (color) {
+        case SSD1306_COLOR_OFF:
+            *byte &= ~bit;
+            break;
+        case SSD1306_COLOR_ON:
+            *byte |= bit;
+            break;
+        default: /* SSD1306_COLOR_INVERT */
+            *byte ^= bit;
+            break;
+    }
+
+    ssd1306_canvas_mark_dirty(canvas, x, y, 1, 1);
+}
+
+bool
+ssd1306_canvas_get_pixel(const struct ssd1306_canvas *canvas, int16_t x,
+                         int16_t y)
+{
+    if (x < 0 || x >= canvas->width || y < 0 || y >= canvas->height) {
+        return false;
+    }
+
+    return (canvas->buf[y * canvas->stride + x / 8] >> (x % 8)) & 0x01;
+}
+
+/**
+ * Transposes the blocks of a band that hold columns @c first_col to
+ * @c last_col and sends those columns.
+ */
+static enum ssd1306_err
+flush_band(struct ssd1306_ctx *ctx, const struct ssd1306_canvas *canvas,
+           uint8_t band, uint8_t first_col, uint8_t last_col)
+{
+    uint8_t blocks[SSD1306_FB_MAX_WIDTH];
+    size_t first_block = first_col / 8;
+    size_t num_blocks = last_col / 8 - first_block + 1;
+    const uint8_t *rows =
+        &canvas->buf[band * SSD1306_ROWS_PER_PAGE * canvas->stride];
+
+    /* Gather the 8 rows of each block so they're back to back. */
+    for (size_t r = 0; r < SSD1306_ROWS_PER_PAGE; r++) {
+        const uint8_t *line = &rows[r * canvas->stride + first_block];
+
+        for (size_t block = 0; block < num_blocks; block++) {
+            blocks[block * 8 + r] = line[block];
+        }
+    }
+
+    ssd1306_transpose_8x8_batch(blocks, blocks, num_blocks);
+
+    return ssd1306_write_data_list(ctx, &blocks[first_col - first_block * 8],
+                                   last_col - first_col + 1);
+}
+
+/**
+ * Sends a window of a canvas to a display rotated a quarter turn. Band
+ * @c band of the canvas is columns @c band * 8 to @c band * 8 + 7 of the
+ * display, and byte @c x / 8 of each of its rows is that row's byte of page
+ * @c x / 8.
+ *
+ * @param ctx    struct that contains the platform dependent I/O
+ * @param canvas canvas to send from
+ * @param window bands of the canvas and pages of the display to send
+ */
+static enum ssd1306_err
+flush_portrait_window(struct ssd1306_ctx *ctx,
+                      const struct ssd1306_canvas *canvas,
+                      const struct ssd1306_window *window)
+{
+    uint8_t col_bytes[SSD1306_FB_MAX_HEIGHT];
+    size_t first_row = (size_t)window->first_page * SSD1306_ROWS_PER_PAGE;
+    size_t num_rows = (size_t)(window->last_page - window->first_page + 1)
+                      * SSD1306_ROWS_PER_PAGE;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(
+        ctx, (uint8_t)first_row, (uint8_t)(first_row + num_rows - 1)));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, window->first_col, window->last_col));
+
+    /* Each page of the display is a column of bytes down the canvas. */
+    for (uint8_t ram = window->first_col; ram <= window->last_col; ram++) {
+        const uint8_t *byte = &canvas->buf[first_row * canvas->stride + ram];
+
+        for (size_t row = 0; row < num_rows; row++) {
+            col_bytes[row] = byte[row * canvas->stride];
+        }
+
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_write_data_list(ctx, col_bytes, num_rows));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * @ref ssd1306_canvas_flush for a display rotated a quarter turn. Windows are
+ * planned over the canvas's bands with the display's pages, 8 columns of the
+ * canvas each, standing in for columns.
+ */
+static enum ssd1306_err
+flush_portrait(struct ssd1306_ctx *ctx, struct ssd1306_canvas *canvas)
+{
+    const struct ssd1306_spans dirty = dirty_spans(canvas);
+    uint8_t first_ram[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+    uint8_t last_ram[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+    const struct ssd1306_spans spans = {
+        .first = first_ram,
+        .last = last_ram,
+        .num_pages = dirty.num_pages,
+        .width = canvas->width / SSD1306_ROWS_PER_PAGE,
+        .col_bytes = SSD1306_ROWS_PER_PAGE,
+    };
+    uint8_t band = 0;
+
+    for (uint8_t b = 0; b < dirty.num_pages; b++) {
+        bool is_dirty = ssd1306_spans_is_dirty(&dirty, b);
+
+        first_ram[b] = is_dirty ? dirty.first[b] / SSD1306_ROWS_PER_PAGE : 1;
+        last_ram[b] = is_dirty ? dirty.last[b] / SSD1306_ROWS_PER_PAGE : 0;
+    }
+
+    while (band < spans.num_pages) {
+        if (!ssd1306_spans_is_dirty(&spans, band)) {
+            band++;
+            continue;
+        }
+
+        struct ssd1306_window window;
+
+        ssd1306_window_grow(&spans, NULL, band, NULL, NULL, &window);
+
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+        SSD1306_RETURN_ON_ERR(flush_portrait_window(ctx, canvas, &window));
+
+        band = window.last_page + 1;
+    }
+
+    ssd1306_spans_mark_clean(&dirty);
+
+    return ssd1306_resume_scrolling(ctx);
+}
+
+enum ssd1306_err
+ssd1306_canvas_flush(struct ssd1306_ctx *ctx, struct ssd1306_canvas *canvas)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (canvas == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        if (canvas->width > ctx->height || canvas->height > ctx->width
+            || canvas->width % SSD1306_ROWS_PER_PAGE != 0) {
+            return SSD1306_OUT_OF_DIMENSION;
+        }
+
+        return flush_portrait(ctx, canvas);
+    }
+    else if (canvas->width > ctx->width || canvas->height > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    const struct ssd1306_spans spans = dirty_spans(canvas);
+    uint8_t band = 0;
+
+    while (band < spans.num_pages) {
+        if (!ssd1306_spans_is_dirty(&spans, band)) {
+            band++;
+            continue;
+        }
+
+        struct ssd1306_window window;
+
+        ssd1306_window_grow(&spans, NULL, band, NULL, NULL, &window);
+
+        /* Writing RAM while the display scrolls corrupts it. */
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_set_col_range(ctx, window.first_col, window.last_col));
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_set_page_range(ctx, window.first_page, window.last_page));
+
+        /* The window wraps from one page to the next on its own. */
+        for (uint8_t b = window.first_page; b <= window.last_page; b++) {
+            SSD1306_RETURN_ON_ERR(flush_band(ctx, canvas, b, window.first_col,
+                                             window.last_col));
+        }
+
+        band = window.last_page + 1;
+    }
+
+    ssd1306_spans_mark_clean(&spans);
+
+    return ssd1306_resume_scrolling(ctx);
+}
@@ -0,0 +1,240 @@
+#include "ssd1306/chart.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include "page.h"
+
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * Value of @ref ssd1306_chart::trace_first for a blank column.
+ */
+#define BLANK UINT8_MAX
+
+/**
+ * A page of blank columns, written to clear the chart.
+ */
+static const uint8_t blank[SSD1306_FB_MAX_WIDTH];
+
+/**
+ * Draws the latest sample in @c cols columns, starting at column @c x of the
+ * display and column @c ring of the chart. The first one is joined to the
+ * last sample drawn.
+ */
+static enum ssd1306_err
+draw_cols(struct ssd1306_ctx *ctx, struct ssd1306_chart *chart, uint8_t x,
+          uint8_t ring, uint16_t cols)
+{
+    uint8_t first[SSD1306_FB_MAX_WIDTH];
+    uint8_t last[SSD1306_FB_MAX_WIDTH];
+    uint8_t first_row = UINT8_MAX;
+    uint8_t last_row = 0;
+
+    /* Only the pages the new trace or the one it replaces touch are sent. */
+    for (uint16_t i = 0; i < cols; i++) {
+        uint8_t col = (uint8_t)((ring + i) % chart->width);
+        uint8_t from = i == 0 ? chart->last_row : chart->row;
+
+        first[i] = from < chart->row ? from : chart->row;
+        last[i] = from > chart->row ? from : chart->row;
+
+        if (first[i] < first_row) {
+            first_row = first[i];
+        }
+        if (last[i] > last_row) {
+            last_row = last[i];
+        }
+        if (chart->trace_first[col] != BLANK) {
+            if (chart->trace_first[col] < first_row) {
+                first_row = chart->trace_first[col];
+            }
+            if (chart->trace_last[col] > last_row) {
+                last_row = chart->trace_last[col];
+            }
+        }
+    }
+
+    uint8_t first_page = (uint8_t)(first_row / SSD1306_ROWS_PER_PAGE);
+    uint8_t last_page = (uint8_t)(last_row / SSD1306_ROWS_PER_PAGE);
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    /*
+     * A single column is the same in either mode. Wider windows are sent
+     * column after column, like the trace is computed.
+     */
+    if (cols > 1) {
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_set_addr_mode(ctx, SSD1306_VERT_ADDR_MODE));
+    }
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, x, (uint8_t)(x + cols - 1)));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, (uint8_t)(chart->first_page + first_page),
+                               (uint8_t)(chart->first_page + last_page)));
+
+    for (uint16_t i = 0; i < cols; i++) {
+        uint8_t col = (uint8_t)((ring + i) % chart->width);
+
+        for (uint8_t page = first_page; page <= last_page; page++) {
+            SSD1306_RETURN_ON_ERR(ssd1306_chunk_push(
+                ctx, &chunk, ssd1306_page_bits(page, first[i], last[i])));
+        }
+
+        chart->trace_first[col] = first[i];
+        chart->trace_last[col] = last[i];
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
+
+    if (cols > 1) {
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_set_addr_mode(ctx, SSD1306_HORIZ_ADDR_MODE));
+    }
+
+    chart->last_row = chart->row;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_chart_init(struct ssd1306_ctx *ctx, struct ssd1306_chart *chart,
+                   enum ssd1306_chart_mode mode, uint8_t first_page,
+                   uint8_t pages, const struct ssd1306_frame_clock *clock,
+                   enum ssd1306_scroll_step interval)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (chart == NULL || (mode == SSD1306_CHART_SCROLL && clock == NULL)) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* Samples are columns of the RAM's pages, as is the scroll. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+    else if (pages == 0 || ctx->width > SSD1306_FB_MAX_WIDTH
+             || (first_page + pages) * SSD1306_ROWS_PER_PAGE > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    uint8_t last_page = (uint8_t)(first_page + pages - 1);
+
+    chart->mode = (uint8_t)mode;
+    chart->first_page = first_page;
+    chart->pages = pages;
+    chart->width = (uint8_t)ctx->width;
+    chart->cursor = 0;
+    chart->last_row = (uint8_t)(pages * SSD1306_ROWS_PER_PAGE - 1);
+    chart->row = chart->last_row;
+
+    for (uint8_t col = 0; col < chart->width; col++) {
+        chart->trace_first[col] = BLANK;
+        chart->trace_last[col] = 0;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_stop_scrolling(ctx));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, 0, (uint8_t)(ctx->width - 1)));
+    SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(ctx, first_page, last_page));
+
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        SSD1306_RETURN_ON_ERR(ssd1306_write_data_list(ctx, blank, ctx->width));
+    }
+
+    if (mode != SSD1306_CHART_SCROLL) {
+        return SSD1306_OK;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_scroll_left(ctx,
+                                              (enum ssd1306_page)first_page,
+                                              interval,
+                                              (enum ssd1306_page)last_page));
+
+    ctx->scroll.clock = clock;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_start_scrolling(ctx));
+
+    chart->steps_drawn = 0;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_chart_tick(struct ssd1306_ctx *ctx, struct ssd1306_chart *chart)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (chart == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+    else if (chart->mode != SSD1306_CHART_SCROLL) {
+        return SSD1306_OK;
+    }
+
+    /* Flushes may have paused the scroll since, which the count allows for. */
+    uint32_t taken = ssd1306_scroll_steps(ctx);
+    uint32_t steps = taken - chart->steps_drawn;
+
+    if (steps == 0) {
+        return SSD1306_OK;
+    }
+
+    /* After a whole turn every column is stale, so redraw them all. */
+    if (steps > chart->width) {
+        chart->cursor =
+            (uint8_t)((chart->cursor + (steps - chart->width)) % chart->width);
+        steps = chart->width;
+    }
+
+    /* Each step wrapped the oldest column around to the right edge. */
+    SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+    SSD1306_RETURN_ON_ERR(draw_cols(ctx, chart,
+                                    (uint8_t)(chart->width - steps),
+                                    chart->cursor, (uint16_t)steps));
+    SSD1306_RETURN_ON_ERR(ssd1306_resume_scrolling(ctx));
+
+    chart->cursor = (uint8_t)((chart->cursor + steps) % chart->width);
+    chart->steps_drawn = taken;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_chart_push(struct ssd1306_ctx *ctx, struct ssd1306_chart *chart,
+                   uint8_t value)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (chart == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    uint8_t top = (uint8_t)(chart->pages * SSD1306_ROWS_PER_PAGE - 1);
+
+    chart->row = (uint8_t)(top - (value > top ? top : value));
+
+    if (chart->mode == SSD1306_CHART_SCROLL) {
+        return ssd1306_chart_tick(ctx, chart);
+    }
+
+    SSD1306_RETURN_ON_ERR(
+        draw_cols(ctx, chart, chart->cursor, chart->cursor, 1));
+
+    chart->cursor = (uint8_t)((chart->cursor + 1) % chart->width);
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,298 @@
+#include "ssd1306/console.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * A page of blank columns, written to clear lines.
+ */
+static const uint8_t blank[SSD1306_FB_MAX_WIDTH];
+
+uint8_t
+ssd1306_console_page(const struct ssd1306_console *console, uint8_t row)
+{
+    uint8_t line = (uint8_t)((console->top + row) % console->ring_lines);
+
+    return (uint8_t)(line * console->font->pages);
+}
+
+/**
+ * Blanks a line of the ring.
+ */
+static enum ssd1306_err
+clear_line(struct ssd1306_ctx *ctx, struct ssd1306_console *console,
+           uint8_t line)
+{
+    uint8_t first_page = (uint8_t)(line * console->font->pages);
+    uint8_t last_page = (uint8_t)(first_page + console->font->pages - 1);
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, 0, (uint8_t)(ctx->width - 1)));
+    SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(ctx, first_page, last_page));
+
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        SSD1306_RETURN_ON_ERR(ssd1306_write_data_list(ctx, blank, ctx->width));
+    }
+
+    /* The pointer wrapped back to the start of the window. */
+    console->ram_page = first_page;
+    console->ram_col = 0;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_console_init(struct ssd1306_ctx *ctx, struct ssd1306_console *console)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (console == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* Lines are pages of the RAM and scroll through the start line. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+
+    if (font->pages == 0 || SSD1306_FB_MAX_PAGES % font->pages != 0
+        || ctx->width > SSD1306_FB_MAX_WIDTH || ctx->width < font->width
+        || ctx->height < font->pages * SSD1306_ROWS_PER_PAGE) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    console->font = font;
+    console->cols = (uint8_t)(ctx->width / font->width);
+    console->rows =
+        (uint8_t)(ctx->height / (font->pages * SSD1306_ROWS_PER_PAGE));
+    console->ring_lines = (uint8_t)(SSD1306_FB_MAX_PAGES / font->pages);
+    console->top = 0;
+    console->cursor_col = 0;
+    console->cursor_row = 0;
+
+    if (console->rows > console->ring_lines) {
+        console->rows = console->ring_lines;
+    }
+
+    /* Lines off screen scroll in later, so the whole ring gets cleared. */
+    for (uint8_t line = 0; line < console->ring_lines; line++) {
+        SSD1306_RETURN_ON_ERR(clear_line(ctx, console, line));
+    }
+
+    return ssd1306_set_start_line(ctx, SSD1306_ROW_0);
+}
+
+enum ssd1306_err
+ssd1306_console_scroll(struct ssd1306_ctx *ctx,
+                       struct ssd1306_console *console)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (console == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    uint8_t exposed =
+        (uint8_t)((console->top + console->rows) % console->ring_lines);
+
+    /*
+     * Clear first: on panels shorter than the ring the line is off screen,
+     * on 64 row ones the top line vanishes a moment before it would anyway.
+     */
+    SSD1306_RETURN_ON_ERR(clear_line(ctx, console, exposed));
+
+    console->top = (uint8_t)((console->top + 1) % console->ring_lines);
+
+    return ssd1306_set_start_line(
+        ctx, (enum ssd1306_row)(ssd1306_console_page(console, 0)
+                                * SSD1306_ROWS_PER_PAGE));
+}
+
+/**
+ * Points the display's RAM at the cell a run of 1 page characters starts in,
+ * unless the pointer is already there.
+ */
+static enum ssd1306_err
+seek(struct ssd1306_ctx *ctx, struct ssd1306_console *console, uint8_t page,
+     uint8_t x)
+{
+    if (console->ram_page == page && console->ram_col == x) {
+        return SSD1306_OK;
+    }
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, x, (uint8_t)(ctx->width - 1)));
+    SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(ctx, page, page));
+
+    console->ram_page = page;
+    console->ram_col = x;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+push_glyph(struct ssd1306_ctx *ctx, struct ssd1306_data_chunk *chunk,
+           const uint8_t *glyph, size_t len, bool invert)
+{
+    if (!invert) {
+        return ssd1306_chunk_push_list(ctx, chunk, glyph, len);
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_chunk_push(ctx, chunk, (uint8_t)~glyph[i]));
+    }
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_console_draw(struct ssd1306_ctx *ctx, struct ssd1306_console *console,
+                     uint8_t row, uint8_t col, const uint8_t *chars,
+                     size_t len, bool invert)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (console == NULL || chars == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+    else if (row >= console->rows || col >= console->cols) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    const struct ssd1306_font *font = console->font;
+    size_t glyph_len = (size_t)font->width * font->pages;
+    uint8_t page = ssd1306_console_page(console, row);
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    if (len > (size_t)(console->cols - col)) {
+        len = console->cols - col;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t x = (uint8_t)((col + i) * font->width);
+        const uint8_t *glyph;
+
+        SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, chars[i], &glyph));
+
+        if (font->pages == 1) {
+            /* Single page glyphs are laid out like a line: share a window. */
+            if (i == 0) {
+                SSD1306_RETURN_ON_ERR(seek(ctx, console, page, x));
+            }
+        }
+        else {
+            /* Taller glyphs are stored page by page and need their own. */
+            SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
+            SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(
+                ctx, x, (uint8_t)(x + font->width - 1)));
+            SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(
+                ctx, page, (uint8_t)(page + font->pages - 1)));
+            console->ram_page = SSD1306_CONSOLE_RAM_UNKNOWN;
+        }
+
+        SSD1306_RETURN_ON_ERR(
+            push_glyph(ctx, &chunk, glyph, glyph_len, invert));
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
+
+    if (font->pages == 1 && len != 0) {
+        unsigned end = (col + len) * font->width;
+
+        /* The pointer wraps to the start of the window at the right edge. */
+        if (end >= ctx->width) {
+            console->ram_page = SSD1306_CONSOLE_RAM_UNKNOWN;
+        }
+        else {
+            console->ram_col = (uint8_t)end;
+        }
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Moves the cursor to the start of the next line, scrolling at the bottom.
+ */
+static enum ssd1306_err
+new_line(struct ssd1306_ctx *ctx, struct ssd1306_console *console)
+{
+    console->cursor_col = 0;
+
+    if (console->cursor_row + 1 < console->rows) {
+        console->cursor_row++;
+        return SSD1306_OK;
+    }
+
+    return ssd1306_console_scroll(ctx, console);
+}
+
+enum ssd1306_err
+ssd1306_console_write(struct ssd1306_ctx *ctx, struct ssd1306_console *console,
+                      const uint8_t *data, size_t len)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (console == NULL || data == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    size_t i = 0;
+
+    while (i < len) {
+        if (data[i] == '\n') {
+            SSD1306_RETURN_ON_ERR(new_line(ctx, console));
+            i++;
+            continue;
+        }
+        else if (data[i] == '\r') {
+            console->cursor_col = 0;
+            i++;
+            continue;
+        }
+
+        if (console->cursor_col == console->cols) {
+            SSD1306_RETURN_ON_ERR(new_line(ctx, console));
+        }
+
+        /* Draw the run of characters that fits on the line in one go. */
+        size_t run = 0;
+        size_t room = console->cols - console->cursor_col;
+
+        while (i + run < len && run < room && data[i + run] != '\n'
+               && data[i + run] != '\r') {
+            run++;
+        }
+
+        SSD1306_RETURN_ON_ERR(ssd1306_console_draw(
+            ctx, console, console->cursor_row, console->cursor_col, &data[i],
+            run, false));
+
+        console->cursor_col = (uint8_t)(console->cursor_col + run);
+        i += run;
+    }
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,213 @@
+#include "ssd1306/dither.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/ssd1306.h"
+#include "ssd1306/transpose.h"
+
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memset */
+
+#if !defined(SSD1306_NO_SIMD) && defined(__SSE2__)
+#define DITHER_SSE2
+#include <emmintrin.h>
+#elif !defined(SSD1306_NO_SIMD) && defined(__ARM_NEON)
+#define DITHER_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * Pixels compared per SIMD instruction.
+ */
+#define LANES 16
+
+/**
+ * A pixel is on when its level is greater than its threshold.
+ */
+#define THRESHOLD 127
+
+/**
+ * The 8x8 Bayer matrix scaled to gray levels: 4 * b + 2 for each entry b.
+ * Each row is repeated so 16 consecutive pixels can use a row as is.
+ */
+static const uint8_t bayer[SSD1306_ROWS_PER_PAGE][LANES] = {
+#define R(a, b, c, d, e, f, g, h)                                              \
+    {4 * a + 2, 4 * b + 2, 4 * c + 2, 4 * d + 2, 4 * e + 2, 4 * f + 2,       \
+     4 * g + 2, 4 * h + 2, 4 * a + 2, 4 * b + 2, 4 * c + 2, 4 * d + 2,       \
+     4 * e + 2, 4 * f + 2, 4 * g + 2, 4 * h + 2}
+    R(0, 32, 8, 40, 2, 34, 10, 42),  R(48, 16, 56, 24, 50, 18, 58, 26),
+    R(12, 44, 4, 36, 14, 46, 6, 38), R(60, 28, 52, 20, 62, 30, 54, 22),
+    R(3, 35, 11, 43, 1, 33, 9, 41),  R(51, 19, 59, 27, 49, 17, 57, 25),
+    R(15, 47, 7, 39, 13, 45, 5, 37), R(63, 31, 55, 23, 61, 29, 53, 21),
+#undef R
+};
+
+/**
+ * The same threshold for every pixel.
+ */
+static const uint8_t flat[LANES] = {
+    THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD,
+    THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD,
+    THRESHOLD, THRESHOLD, THRESHOLD, THRESHOLD,
+};
+
+enum ssd1306_err
+ssd1306_ditherer_init(struct ssd1306_ditherer *ditherer,
+                      enum ssd1306_dither mode, uint16_t width,
+                      uint16_t first_row, uint8_t *dst)
+{
+    if (ditherer == NULL || dst == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (width == 0 || width > SSD1306_IMAGE_MAX_WIDTH
+             || first_row % SSD1306_ROWS_PER_PAGE != 0) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    ditherer->mode = mode;
+    ditherer->width = width;
+    ditherer->row = first_row;
+    ditherer->dst = dst;
+
+    memset(ditherer->err, 0, sizeof(ditherer->err));
+
+    return SSD1306_OK;
+}
+
+/**
+ * Compares @c len gray levels against a row of 16 repeating thresholds and
+ * packs the result, least significant bit first, into @c bits.
+ */
+static void
+compare_row(const uint8_t *gray, const uint8_t *thresholds, size_t len,
+            uint8_t *bits)
+{
+    size_t x = 0;
+
+#if defined(DITHER_SSE2)
+    /* SSE2 only compares signed bytes, so move both into signed range. */
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+    const __m128i t = _mm_xor_si128(
+        _mm_loadu_si128((const __m128i *)thresholds), bias);
+
+    for (; x + LANES <= len; x += LANES) {
+        __m128i g = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&gray[x]),
+                                  bias);
+        int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(g, t));
+
+        bits[x / 8] = (uint8_t)mask;
+        bits[x / 8 + 1] = (uint8_t)(mask >> 8);
+    }
+#elif defined(DITHER_NEON)
+    static const uint8_t weights[LANES] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                           1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t t = vld1q_u8(thresholds);
+    const uint8x16_t w = vld1q_u8(weights);
+
+    for (; x + LANES <= len; x += LANES) {
+        uint8x16_t on = vandq_u8(vcgtq_u8(vld1q_u8(&gray[x]), t), w);
+        /* Adding up the weights of each half packs it into a byte. */
+        uint64x2_t sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(on)));
+
+        bits[x / 8] = (uint8_t)vgetq_lane_u64(sums, 0);
+        bits[x / 8 + 1] = (uint8_t)vgetq_lane_u64(sums, 1);
+    }
+#endif
+
+    for (; x < len; x += 8) {
+        uint8_t byte = 0x00;
+
+        for (size_t bit = 0; bit < 8 && x + bit < len; bit++) {
+            if (gray[x + bit] > thresholds[(x + bit) % LANES]) {
+                byte |= 1U << bit;
+            }
+        }
+
+        bits[x / 8] = byte;
+    }
+}
+
+/**
+ * Floyd-Steinberg dithers a row. @c err holds the error diffused into this
+ * row by the previous one and is overwritten with the error for the next row.
+ */
+static void
+diffuse_row(const uint8_t *gray, int16_t *err, size_t len, uint8_t *bits)
+{
+    /* Error going right, and error going down and to the right. */
+    int right = 0;
+    int down_right = 0;
+
+    memset(bits, 0x00, (len + 7) / 8);
+
+    for (size_t x = 0; x < len; x++) {
+        int level = gray[x] + err[x] + right;
+        int out = level > THRESHOLD ? 255 : 0;
+        int e = level - out;
+        int e7 = e * 7 / 16;
+        int e3 = e * 3 / 16;
+        int e5 = e * 5 / 16;
+
+        if (out != 0) {
+            bits[x / 8] |= 1U << (x % 8);
+        }
+
+        /* err[x - 1] was already used by this row and now holds the next's. */
+        if (x > 0) {
+            err[x - 1] = (int16_t)(err[x - 1] + e3);
+        }
+
+        err[x] = (int16_t)(e5 + down_right);
+        right = e7;
+        down_right = e - e7 - e3 - e5;
+    }
+}
+
+/**
+ * Transposes the rows buffered so far into the page they belong to.
+ */
+static void
+write_page(struct ssd1306_ditherer *ditherer, uint16_t rows)
+{
+    uint16_t page = (ditherer->row - 1) / SSD1306_ROWS_PER_PAGE;
+
+    ssd1306_rows_to_pages(&ditherer->rows[0][0], sizeof(ditherer->rows[0]),
+                          ditherer->width, rows, SSD1306_LSB_FIRST,
+                          &ditherer->dst[(size_t)page * ditherer->width]);
+}
+
+void
+ssd1306_ditherer_push_row(struct ssd1306_ditherer *ditherer,
+                          const uint8_t *gray)
+{
+    uint16_t r = ditherer->row % SSD1306_ROWS_PER_PAGE;
+    uint8_t *bits = ditherer->rows[r];
+
+    switch (ditherer->mode) {
+        case SSD1306_DITHER_THRESHOLD:
+            compare_row(gray, flat, ditherer->width, bits);
+            break;
+        case SSD1306_DITHER_ORDERED:
+            compare_row(gray, bayer[r], ditherer->width, bits);
+            break;
+        default: /* SSD1306_DITHER_FLOYD_STEINBERG */
+            diffuse_row(gray, ditherer->err, ditherer->width, bits);
+            break;
+    }
+
+    ditherer->row++;
+
+    if (r == SSD1306_ROWS_PER_PAGE - 1) {
+        write_page(ditherer, SSD1306_ROWS_PER_PAGE);
+    }
+}
+
+void
+ssd1306_ditherer_finish(struct ssd1306_ditherer *ditherer)
+{
+    uint16_t rows = ditherer->row % SSD1306_ROWS_PER_PAGE;
+
+    if (rows != 0) {
+        write_page(ditherer, rows);
+    }
+}
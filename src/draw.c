@@ -0,0 +1,452 @@
+#include "ssd1306/draw.h"
+
+#include "ssd1306/fb.h"
+#include "ssd1306/ssd1306.h"
+
+#include "page.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+#include <string.h> /* memset */
+
+/**
+ * Centers of the four quadrants of a circle. They're all the same for a
+ * circle and pulled apart to the corners of a rounded rectangle.
+ */
+struct arc {
+    long left;   /**< column of the center of the left quadrants */
+    long right;  /**< column of the center of the right quadrants */
+    long top;    /**< row of the center of the top quadrants */
+    long bottom; /**< row of the center of the bottom quadrants */
+};
+
+/**
+ * Called by @ref walk_arc for each run of pixels of an octant that share the
+ * same @c y.
+ */
+typedef void (*arc_run_fn)(struct ssd1306_fb *fb, const struct arc *arc,
+                           long y, long x_first, long x_last,
+                           enum ssd1306_color color);
+
+static void
+apply(uint8_t *byte, uint8_t mask, enum ssd1306_color color)
+{
+    switch (color) {
+        case SSD1306_COLOR_OFF:
+            *byte &= ~mask;
+            break;
+        case SSD1306_COLOR_ON:
+            *byte |= mask;
+            break;
+        default: /* SSD1306_COLOR_INVERT */
+            *byte ^= mask;
+            break;
+    }
+}
+
+/**
+ * Draws columns @c x0 to @c x1 of row @c y: the same bit of consecutive bytes.
+ */
+static void
+hspan(struct ssd1306_fb *fb, long x0, long x1, long y,
+      enum ssd1306_color color)
+{
+    if (y < 0 || y >= fb->height) {
+        return;
+    }
+
+    if (x0 < 0) {
+        x0 = 0;
+    }
+
+    if (x1 >= fb->width) {
+        x1 = fb->width - 1;
+    }
+
+    if (x0 > x1) {
+        return;
+    }
+
+    uint8_t bit = 1U << (y % SSD1306_ROWS_PER_PAGE);
+    uint8_t *row = &fb->buf[(y / SSD1306_ROWS_PER_PAGE) * fb->width];
+
+    for (long x = x0; x <= x1; x++) {
+        apply(&row[x], bit, color);
+    }
+
+    ssd1306_fb_mark_dirty(fb, (int16_t)x0, (int16_t)y, (int16_t)(x1 - x0 + 1),
+                          1);
+}
+
+/**
+ * Draws rows @c y0 to @c y1 of column @c x: whole bytes for the pages it
+ * covers entirely and masked bytes at both ends.
+ */
+static void
+vspan(struct ssd1306_fb *fb, long x, long y0, long y1,
+      enum ssd1306_color color)
+{
+    if (x < 0 || x >= fb->width) {
+        return;
+    }
+
+    if (y0 < 0) {
+        y0 = 0;
+    }
+
+    if (y1 >= fb->height) {
+        y1 = fb->height - 1;
+    }
+
+    if (y0 > y1) {
+        return;
+    }
+
+    long first_page = y0 / SSD1306_ROWS_PER_PAGE;
+    long last_page = y1 / SSD1306_ROWS_PER_PAGE;
+    uint8_t *col = &fb->buf[x];
+
+    if (first_page == last_page) {
+        apply(&col[first_page * fb->width],
+              ssd1306_page_bits(first_page, y0, y1), color);
+    }
+    else {
+        apply(&col[first_page * fb->width],
+              ssd1306_page_bits(first_page, y0, y1), color);
+
+        for (long page = first_page + 1; page < last_page; page++) {
+            apply(&col[page * fb->width], 0xFF, color);
+        }
+
+        apply(&col[last_page * fb->width],
+              ssd1306_page_bits(last_page, y0, y1), color);
+    }
+
+    ssd1306_fb_mark_dirty(fb, (int16_t)x, (int16_t)y0, 1,
+                          (int16_t)(y1 - y0 + 1));
+}
+
+/**
+ * Walks one octant of a circle of radius @c r with the midpoint circle
+ * algorithm, from the top (x = 0, y = r) down to the diagonal, and hands each
+ * run of pixels that share a @c y to @c run.
+ */
+static void
+walk_arc(struct ssd1306_fb *fb, const struct arc *arc, long r, arc_run_fn run,
+         enum ssd1306_color color)
+{
+    long x = 0;
+    long y = r;
+    long d = 1 - r;
+    long x_first = 0;
+
+    while (x <= y) {
+        if (d < 0) {
+            d += 2 * x + 3;
+        }
+        else {
+            run(fb, arc, y, x_first, x, color);
+            d += 2 * (x - y) + 5;
+            y--;
+            x_first = x + 1;
+        }
+
+        x++;
+    }
+
+    if (x_first < x) {
+        run(fb, arc, y, x_first, x - 1, color);
+    }
+}
+
+/**
+ * Draws a run of the outline in all eight octants. Pixels on the axes
+ * (x = 0) are left to the caller and pixels on the diagonal are only drawn by
+ * the horizontal octants, so nothing is drawn twice.
+ */
+static void
+outline_run(struct ssd1306_fb *fb, const struct arc *arc, long y, long x_first,
+            long x_last, enum ssd1306_color color)
+{
+    long first = x_first > 0 ? x_first : 1;
+    long last = x_last < y ? x_last : y - 1;
+
+    if (first <= x_last) {
+        hspan(fb, arc->left - x_last, arc->left - first, arc->top - y, color);
+        hspan(fb, arc->right + first, arc->right + x_last, arc->top - y, color);
+        hspan(fb, arc->left - x_last, arc->left - first, arc->bottom + y,
+              color);
+        hspan(fb, arc->right + first, arc->right + x_last, arc->bottom + y,
+              color);
+    }
+
+    if (first <= last) {
+        vspan(fb, arc->left - y, arc->top - last, arc->top - first, color);
+        vspan(fb, arc->left - y, arc->bottom + first, arc->bottom + last,
+              color);
+        vspan(fb, arc->right + y, arc->top - last, arc->top - first, color);
+        vspan(fb, arc->right + y, arc->bottom + first, arc->bottom + last,
+              color);
+    }
+}
+
+/**
+ * Fills the columns a run of the outline bounds. The center column(s) are
+ * left to the caller.
+ */
+static void
+fill_run(struct ssd1306_fb *fb, const struct arc *arc, long y, long x_first,
+         long x_last, enum ssd1306_color color)
+{
+    for (long x = x_first > 0 ? x_first : 1; x <= x_last; x++) {
+        vspan(fb, arc->left - x, arc->top - y, arc->bottom + y, color);
+        vspan(fb, arc->right + x, arc->top - y, arc->bottom + y, color);
+    }
+
+    /* Column y was filled above when the run reaches the diagonal. */
+    if (y > x_last) {
+        vspan(fb, arc->left - y, arc->top - x_last, arc->bottom + x_last,
+              color);
+        vspan(fb, arc->right + y, arc->top - x_last, arc->bottom + x_last,
+              color);
+    }
+}
+
+void
+ssd1306_fb_hline(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t w,
+                 enum ssd1306_color color)
+{
+    if (w != 0) {
+        hspan(fb, x, (long)x + w - 1, y, color);
+    }
+}
+
+void
+ssd1306_fb_vline(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t h,
+                 enum ssd1306_color color)
+{
+    if (h != 0) {
+        vspan(fb, x, y, (long)y + h - 1, color);
+    }
+}
+
+void
+ssd1306_fb_line(struct ssd1306_fb *fb, int16_t x0, int16_t y0, int16_t x1,
+                int16_t y1, enum ssd1306_color color)
+{
+    long dx = x1 > x0 ? (long)x1 - x0 : (long)x0 - x1;
+    long dy = y1 > y0 ? (long)y1 - y0 : (long)y0 - y1;
+
+    if (dx >= dy) {
+        /* Walk left to right, one horizontal span per row. */
+        if (x0 > x1) {
+            int16_t tmp_x = x0, tmp_y = y0;
+
+            x0 = x1, y0 = y1;
+            x1 = tmp_x, y1 = tmp_y;
+        }
+
+        long step = y1 > y0 ? 1 : -1;
+        long err = dx / 2;
+        long y = y0;
+        long run_first = x0;
+
+        for (long x = x0; x <= x1; x++) {
+            err -= dy;
+
+            if (err < 0) {
+                hspan(fb, run_first, x, y, color);
+                y += step;
+                err += dx;
+                run_first = x + 1;
+            }
+        }
+
+        if (run_first <= x1) {
+            hspan(fb, run_first, x1, y, color);
+        }
+    }
+    else {
+        /* Walk top to bottom, one vertical span per column. */
+        if (y0 > y1) {
+            int16_t tmp_x = x0, tmp_y = y0;
+
+            x0 = x1, y0 = y1;
+            x1 = tmp_x, y1 = tmp_y;
+        }
+
+        long step = x1 > x0 ? 1 : -1;
+        long err = dy / 2;
+        long x = x0;
+        long run_first = y0;
+
+        for (long y = y0; y <= y1; y++) {
+            err -= dx;
+
+            if (err < 0) {
+                vspan(fb, x, run_first, y, color);
+                x += step;
+                err += dy;
+                run_first = y + 1;
+            }
+        }
+
+        if (run_first <= y1) {
+            vspan(fb, x, run_first, y1, color);
+        }
+    }
+}
+
+void
+ssd1306_fb_rect(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t w,
+                uint16_t h, enum ssd1306_color color)
+{
+    if (w == 0 || h == 0) {
+        return;
+    }
+
+    long right = (long)x + w - 1;
+    long bottom = (long)y + h - 1;
+
+    hspan(fb, x, right, y, color);
+
+    if (h > 1) {
+        hspan(fb, x, right, bottom, color);
+    }
+
+    vspan(fb, x, (long)y + 1, bottom - 1, color);
+
+    if (w > 1) {
+        vspan(fb, right, (long)y + 1, bottom - 1, color);
+    }
+}
+
+void
+ssd1306_fb_fill_rect(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t w,
+                     uint16_t h, enum ssd1306_color color)
+{
+    long x0 = x < 0 ? 0 : x;
+    long x1 = (long)x + w - 1 < fb->width ? (long)x + w - 1 : fb->width - 1;
+    long y0 = y < 0 ? 0 : y;
+    long y1 = (long)y + h - 1 < fb->height ? (long)y + h - 1 : fb->height - 1;
+
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    size_t cols = (size_t)(x1 - x0 + 1);
+
+    for (long page = y0 / SSD1306_ROWS_PER_PAGE;
+         page <= y1 / SSD1306_ROWS_PER_PAGE; page++) {
+        uint8_t mask = ssd1306_page_bits(page, y0, y1);
+        uint8_t *row = &fb->buf[page * fb->width + x0];
+
+        if (mask == 0xFF && color != SSD1306_COLOR_INVERT) {
+            memset(row, color == SSD1306_COLOR_ON ? 0xFF : 0x00, cols);
+            continue;
+        }
+
+        for (size_t col = 0; col < cols; col++) {
+            apply(&row[col], mask, color);
+        }
+    }
+
+    ssd1306_fb_mark_dirty(fb, (int16_t)x0, (int16_t)y0, (int16_t)cols,
+                          (int16_t)(y1 - y0 + 1));
+}
+
+void
+ssd1306_fb_circle(struct ssd1306_fb *fb, int16_t cx, int16_t cy, uint16_t r,
+                  enum ssd1306_color color)
+{
+    const struct arc arc = {cx, cx, cy, cy};
+
+    if (r == 0) {
+        hspan(fb, cx, cx, cy, color);
+        return;
+    }
+
+    /* The four pixels on the axes. */
+    hspan(fb, cx, cx, (long)cy - r, color);
+    hspan(fb, cx, cx, (long)cy + r, color);
+    hspan(fb, (long)cx - r, (long)cx - r, cy, color);
+    hspan(fb, (long)cx + r, (long)cx + r, cy, color);
+
+    walk_arc(fb, &arc, r, outline_run, color);
+}
+
+void
+ssd1306_fb_fill_circle(struct ssd1306_fb *fb, int16_t cx, int16_t cy,
+                       uint16_t r, enum ssd1306_color color)
+{
+    const struct arc arc = {cx, cx, cy, cy};
+
+    vspan(fb, cx, (long)cy - r, (long)cy + r, color);
+
+    walk_arc(fb, &arc, r, fill_run, color);
+}
+
+/**
+ * Shrinks the radius of a rounded rectangle's corners so the corners don't
+ * overlap.
+ */
+static long
+fit_radius(uint16_t w, uint16_t h, uint16_t r)
+{
+    uint16_t shortest = w < h ? w : h;
+    long max_r = shortest == 0 ? 0 : (shortest - 1) / 2;
+
+    return r < max_r ? r : max_r;
+}
+
+void
+ssd1306_fb_round_rect(struct ssd1306_fb *fb, int16_t x, int16_t y, uint16_t w,
+                      uint16_t h, uint16_t r, enum ssd1306_color color)
+{
+    long radius = fit_radius(w, h, r);
+
+    if (radius == 0) {
+        ssd1306_fb_rect(fb, x, y, w, h, color);
+        return;
+    }
+
+    const struct arc arc = {
+        (long)x + radius,
+        (long)x + w - 1 - radius,
+        (long)y + radius,
+        (long)y + h - 1 - radius,
+    };
+
+    hspan(fb, arc.left, arc.right, y, color);
+    hspan(fb, arc.left, arc.right, (long)y + h - 1, color);
+    vspan(fb, x, arc.top, arc.bottom, color);
+    vspan(fb, (long)x + w - 1, arc.top, arc.bottom, color);
+
+    walk_arc(fb, &arc, radius, outline_run, color);
+}
+
+void
+ssd1306_fb_fill_round_rect(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                           uint16_t w, uint16_t h, uint16_t r,
+                           enum ssd1306_color color)
+{
+    long radius = fit_radius(w, h, r);
+
+    if (radius == 0) {
+        ssd1306_fb_fill_rect(fb, x, y, w, h, color);
+        return;
+    }
+
+    const struct arc arc = {
+        (long)x + radius,
+        (long)x + w - 1 - radius,
+        (long)y + radius,
+        (long)y + h - 1 - radius,
+    };
+
+    /* The band between the corners' centers, then the corners' columns. */
+    ssd1306_fb_fill_rect(fb, (int16_t)arc.left, y,
+                         (uint16_t)(arc.right - arc.left + 1), h, color);
+
+    walk_arc(fb, &arc, radius, fill_run, color);
+}
@@ -0,0 +1,347 @@
+#include "ssd1306/fb.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+#include "ssd1306/transpose.h"
+
+#include "page.h"
+#include "window.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memcpy, memset */
+
+static uint8_t
+num_pages(const struct ssd1306_fb *fb)
+{
+    return fb->height / SSD1306_ROWS_PER_PAGE;
+}
+
+/**
+ * Returns the dirty tracker of @c fb.
+ */
+static struct ssd1306_spans
+dirty_spans(struct ssd1306_fb *fb)
+{
+    return (struct ssd1306_spans){
+        .first = fb->dirty_first,
+        .last = fb->dirty_last,
+        .num_pages = num_pages(fb),
+        .width = fb->width,
+        .col_bytes = 1,
+    };
+}
+
+enum ssd1306_err
+ssd1306_fb_init(struct ssd1306_fb *fb, uint8_t *buf, uint16_t width,
+                uint16_t height)
+{
+    if (fb == NULL || buf == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (width == 0 || width > SSD1306_FB_MAX_WIDTH || height == 0
+             || height > SSD1306_FB_MAX_HEIGHT
+             || height % SSD1306_ROWS_PER_PAGE != 0) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    fb->buf = buf;
+    fb->width = width;
+    fb->height = height;
+
+    ssd1306_fb_clear(fb);
+
+    return SSD1306_OK;
+}
+
+void
+ssd1306_fb_clear(struct ssd1306_fb *fb)
+{
+    memset(fb->buf, 0x00, SSD1306_FB_LEN(fb->width, fb->height));
+
+    ssd1306_fb_mark_all_dirty(fb);
+}
+
+void
+ssd1306_fb_mark_dirty(struct ssd1306_fb *fb, int16_t x, int16_t y, int16_t w,
+                      int16_t h)
+{
+    const struct ssd1306_spans spans = dirty_spans(fb);
+
+    ssd1306_spans_mark_dirty(&spans, x, y, w, h);
+}
+
+void
+ssd1306_fb_mark_all_dirty(struct ssd1306_fb *fb)
+{
+    const struct ssd1306_spans spans = dirty_spans(fb);
+
+    ssd1306_spans_mark_all_dirty(&spans);
+}
+
+void
+ssd1306_fb_mark_clean(struct ssd1306_fb *fb)
+{
+    const struct ssd1306_spans spans = dirty_spans(fb);
+
+    ssd1306_spans_mark_clean(&spans);
+}
+
+bool
+ssd1306_fb_is_page_dirty(const struct ssd1306_fb *fb, uint8_t page)
+{
+    return fb->dirty_first[page] <= fb->dirty_last[page];
+}
+
+void
+ssd1306_fb_set_pixel(struct ssd1306_fb *fb, int16_t x, int16_t y,
+                     enum ssd1306_color color)
+{
+    if (x < 0 || x >= fb->width || y < 0 || y >= fb->height) {
+        return;
+    }
+
+    uint8_t *byte = &fb->buf[(y / SSD1306_ROWS_PER_PAGE) * fb->width + x];
+    uint8_t bit = 1U << (y % SSD1306_ROWS_PER_PAGE);
+
+    switch (color) {
+        case SSD1306_COLOR_OFF:
+            *byte &= ~bit;
+            break;
+        case SSD1306_COLOR_ON:
+            *byte |= bit;
+            break;
+        default: /* SSD1306_COLOR_INVERT */
+            *byte ^= bit;
+            break;
+    }
+
+    ssd1306_fb_mark_dirty(fb, x, y, 1, 1);
+}
+
+bool
+ssd1306_fb_get_pixel(const struct ssd1306_fb *fb, int16_t x, int16_t y)
+{
+    if (x < 0 || x >= fb->width || y < 0 || y >= fb->height) {
+        return false;
+    }
+
+    uint8_t byte = fb->buf[(y / SSD1306_ROWS_PER_PAGE) * fb->width + x];
+
+    return (byte >> (y % SSD1306_ROWS_PER_PAGE)) & 0x01;
+}
+
+enum ssd1306_err
+ssd1306_fb_draw_char(struct ssd1306_fb *fb, const struct ssd1306_font *font,
+                     int16_t x, int16_t y, uint8_t c, bool inverted)
+{
+    const uint8_t *glyph;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, c, &glyph));
+
+    int first_col = x < 0 ? -x : 0;
+    int last_col = font->width;
+
+    if (x + last_col > fb->width) {
+        last_col = fb->width - x;
+    }
+
+    int top_page = ssd1306_page_of_row(y);
+    unsigned shift = (unsigned)(y - top_page * SSD1306_ROWS_PER_PAGE);
+    /*
+     * A glyph page shifted down by 'shift' rows straddles two framebuffer
+     * pages. Both halves of the 16 bit mask cover exactly the rows the glyph
+     * page lands on.
+     */
+    uint16_t mask = (uint16_t)(0xFFU << shift);
+    uint8_t upper_mask = (uint8_t)mask;
+    uint8_t lower_mask = (uint8_t)(mask >> 8);
+    uint8_t xor_mask = inverted ? 0xFF : 0x00;
+
+    for (int glyph_page = 0; glyph_page < font->pages; glyph_page++) {
+        const uint8_t *cols = &glyph[glyph_page * font->width];
+        int upper_page = top_page + glyph_page;
+        int lower_page = upper_page + 1;
+        bool draw_upper = upper_page >= 0 && upper_page < num_pages(fb);
+        bool draw_lower =
+            shift != 0 && lower_page >= 0 && lower_page < num_pages(fb);
+
+        for (int col = first_col; col < last_col; col++) {
+            uint8_t col_bits = (uint8_t)(cols[col] ^ xor_mask);
+            uint16_t bits = (uint16_t)(col_bits << shift);
+
+            if (draw_upper) {
+                uint8_t *dst = &fb->buf[upper_page * fb->width + x + col];
+
+                *dst = (*dst & ~upper_mask) | (uint8_t)bits;
+            }
+
+            if (draw_lower) {
+                uint8_t *dst = &fb->buf[lower_page * fb->width + x + col];
+
+                *dst = (*dst & ~lower_mask) | (uint8_t)(bits >> 8);
+            }
+        }
+    }
+
+    ssd1306_fb_mark_dirty(fb, x, y, font->width,
+                          font->pages * SSD1306_ROWS_PER_PAGE);
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_fb_draw_str(struct ssd1306_fb *fb, const struct ssd1306_font *font,
+                    int16_t x, int16_t y, const uint8_t *str, bool inverted)
+{
+    if (str == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    for (; *str != '\0' && x < fb->width; str++, x += font->width) {
+        SSD1306_RETURN_ON_ERR(ssd1306_fb_draw_char(fb, font, x, y, *str,
+                                                   inverted));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Sends a window of a portrait framebuffer to the display. Page @c page of
+ * the framebuffer is columns @c page * 8 to @c page * 8 + 7 of the display,
+ * and its column @c x is row @c x of the display.
+ *
+ * @param ctx    struct that contains the platform dependent I/O
+ * @param fb     framebuffer to send from
+ * @param window pages of the framebuffer and pages of the display to send
+ */
+static enum ssd1306_err
+flush_portrait_window(struct ssd1306_ctx *ctx, const struct ssd1306_fb *fb,
+                      const struct ssd1306_window *window)
+{
+    uint8_t blocks[SSD1306_FB_MAX_WIDTH];
+    size_t num_blocks = (size_t)(window->last_page - window->first_page + 1);
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(
+        ctx, window->first_page * SSD1306_ROWS_PER_PAGE,
+        window->last_page * SSD1306_ROWS_PER_PAGE + 7));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, window->first_col, window->last_col));
+
+    /*
+     * Each page of the display is a row of 8x8 blocks, one per page of the
+     * framebuffer, whose 8 columns are contiguous in it.
+     */
+    for (uint8_t ram = window->first_col; ram <= window->last_col; ram++) {
+        for (size_t i = 0; i < num_blocks; i++) {
+            memcpy(&blocks[i * 8],
+                   &fb->buf[(window->first_page + i) * fb->width
+                            + ram * SSD1306_ROWS_PER_PAGE],
+                   8);
+        }
+
+        ssd1306_transpose_8x8_batch(blocks, blocks, num_blocks);
+
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_write_data_list(ctx, blocks, num_blocks * 8));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * @ref ssd1306_fb_flush for a display rotated a quarter turn. Windows are
+ * planned over the framebuffer's pages with the display's pages, 8 columns of
+ * the framebuffer each, standing in for columns.
+ */
+static enum ssd1306_err
+flush_portrait(struct ssd1306_ctx *ctx, struct ssd1306_fb *fb)
+{
+    uint8_t first_ram[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+    uint8_t last_ram[SSD1306_FB_MAX_HEIGHT / SSD1306_ROWS_PER_PAGE];
+    const struct ssd1306_spans spans = {
+        .first = first_ram,
+        .last = last_ram,
+        .num_pages = num_pages(fb),
+        .width = fb->width / SSD1306_ROWS_PER_PAGE,
+        .col_bytes = SSD1306_ROWS_PER_PAGE,
+    };
+    uint8_t page = 0;
+
+    for (uint8_t p = 0; p < num_pages(fb); p++) {
+        bool dirty = ssd1306_fb_is_page_dirty(fb, p);
+
+        first_ram[p] = dirty ? fb->dirty_first[p] / SSD1306_ROWS_PER_PAGE : 1;
+        last_ram[p] = dirty ? fb->dirty_last[p] / SSD1306_ROWS_PER_PAGE : 0;
+    }
+
+    while (page < num_pages(fb)) {
+        if (!ssd1306_spans_is_dirty(&spans, page)) {
+            page++;
+            continue;
+        }
+
+        struct ssd1306_window window;
+
+        ssd1306_window_grow(&spans, NULL, page, NULL, NULL, &window);
+
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+        SSD1306_RETURN_ON_ERR(flush_portrait_window(ctx, fb, &window));
+
+        page = window.last_page + 1;
+    }
+
+    ssd1306_fb_mark_clean(fb);
+
+    return ssd1306_resume_scrolling(ctx);
+}
+
+enum ssd1306_err
+ssd1306_fb_flush(struct ssd1306_ctx *ctx, struct ssd1306_fb *fb)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (fb == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        if (fb->width > ctx->height || fb->height > ctx->width
+            || fb->width % SSD1306_ROWS_PER_PAGE != 0) {
+            return SSD1306_OUT_OF_DIMENSION;
+        }
+
+        return flush_portrait(ctx, fb);
+    }
+    else if (fb->width > ctx->width || fb->height > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    const struct ssd1306_spans spans = dirty_spans(fb);
+    uint8_t page = 0;
+
+    while (page < spans.num_pages) {
+        if (!ssd1306_spans_is_dirty(&spans, page)) {
+            page++;
+            continue;
+        }
+
+        struct ssd1306_window window;
+
+        ssd1306_window_grow(&spans, NULL, page, NULL, NULL, &window);
+
+        /* Writing RAM while the display scrolls corrupts it. */
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_window_write(ctx, fb->buf, fb->width, 0, &window));
+
+        page = window.last_page + 1;
+    }
+
+    ssd1306_spans_mark_clean(&spans);
+
+    return ssd1306_resume_scrolling(ctx);
+}
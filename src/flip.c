@@ -0,0 +1,87 @@
+#include "ssd1306/flip.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/shadow.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stddef.h> /* NULL */
+#include <stdint.h>
+
+/**
+ * Returns the first row of a half of the display's RAM.
+ */
+static uint16_t
+first_row(const struct ssd1306_flip *flip, uint8_t half)
+{
+    return (uint16_t)(flip->halves[half].first_page * SSD1306_ROWS_PER_PAGE);
+}
+
+enum ssd1306_err
+ssd1306_flip_init(struct ssd1306_ctx *ctx, struct ssd1306_flip *flip,
+                  uint8_t *buf)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (flip == NULL || buf == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ctx->height > SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE / 2) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+
+    for (uint8_t half = 0; half < 2; half++) {
+        SSD1306_RETURN_ON_ERR(ssd1306_shadow_init(
+            &flip->halves[half],
+            &buf[half * SSD1306_FB_LEN(ctx->width, ctx->height)], ctx->width,
+            ctx->height));
+
+        flip->halves[half].first_page = (uint8_t)(half * pages);
+    }
+
+    flip->front = 0;
+
+    return ssd1306_set_start_line(ctx, SSD1306_ROW_0);
+}
+
+enum ssd1306_err
+ssd1306_flip_write(struct ssd1306_ctx *ctx, struct ssd1306_flip *flip,
+                   const uint8_t *frame)
+{
+    if (flip == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    return ssd1306_shadow_flush(ctx, &flip->halves[flip->front ^ 1], frame,
+                                NULL, 0, NULL);
+}
+
+enum ssd1306_err
+ssd1306_flip_swap(struct ssd1306_ctx *ctx, struct ssd1306_flip *flip)
+{
+    if (flip == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    uint8_t back = flip->front ^ 1;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_start_line(
+        ctx, (enum ssd1306_row)first_row(flip, back)));
+
+    flip->front = back;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_flip_present(struct ssd1306_ctx *ctx, struct ssd1306_flip *flip,
+                     const uint8_t *frame)
+{
+    SSD1306_RETURN_ON_ERR(ssd1306_flip_write(ctx, flip, frame));
+
+    return ssd1306_flip_swap(ctx, flip);
+}
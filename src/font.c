@@ -3,9 +3,12 @@
 #include "ssd1306/err.h"
 #include "ssd1306/platform.h"
 #include "ssd1306/ssd1306.h"
+#include "ssd1306/transpose.h"
 
+#include <stdbool.h>
 #include <stddef.h> /* size_t */
 #include <stdint.h>
+#include <string.h> /* strlen */
 
 /**
  * 8x8 monochrome bitmap fonts for rendering
@@ -172,22 +175,410 @@ static const uint8_t font8x8_basic[][FONT_WIDTH] = {
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, /* U+007F ( ) */
 };
 
+const struct ssd1306_font ssd1306_font8x8_basic = {
+    .glyphs = font8x8_basic[0],
+    .width = FONT_WIDTH,
+    .pages = 1,
+    .first_char = 0x00,
+    .num_glyphs = SSD1306_ARRAY_LEN(font8x8_basic),
+};
+
+/**
+ * Lookup tables that expand each bit of a nybble into @c scale bits. The first
+ * table is for a scale of 2, the second for 3 and so on.
+ *
+ * A page byte is expanded by looking up both of its nybbles and placing the
+ * upper nybble's expansion above the lower one's.
+ */
+static const uint16_t expand_nybble[SSD1306_MAX_TEXT_SCALE - 1][16] = {
+    {0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0,
+     0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF},
+    {0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00,
+     0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF},
+    {0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000,
+     0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF},
+};
+
+const struct ssd1306_font *
+ssd1306_get_font(const struct ssd1306_ctx *ctx)
+{
+    if (ctx == NULL || ctx->font == NULL) {
+        return &ssd1306_font8x8_basic;
+    }
+
+    return ctx->font;
+}
+
+enum ssd1306_err
+ssd1306_find_glyph(const struct ssd1306_font *font, uint8_t c,
+                   const uint8_t **glyph)
+{
+    if (c < font->first_char || c - font->first_char >= font->num_glyphs) {
+        return SSD1306_GLYPH_NOT_IN_FONT;
+    }
+
+    size_t glyph_len = (size_t)font->width * font->pages;
+
+    *glyph = &font->glyphs[(c - font->first_char) * glyph_len];
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_emit_char(struct ssd1306_ctx *ctx, struct ssd1306_data_chunk *chunk,
+                  uint8_t c)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        /* Glyphs are laid out for landscape, see ssd1306_write_str_portrait. */
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+    const uint8_t *glyph;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, c, &glyph));
+
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_push_list(
+        ctx, chunk, glyph, (size_t)font->width * font->pages));
+
+    return SSD1306_OK;
+}
+
 enum ssd1306_err
 ssd1306_write_str(struct ssd1306_ctx *ctx, const uint8_t *str)
 {
+    if (str == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
     for (uint8_t c = *str; *str != '\0'; c = *(++str)) {
-        SSD1306_RETURN_ON_ERR(ssd1306_write_char(ctx, c));
+        SSD1306_RETURN_ON_ERR(ssd1306_emit_char(ctx, &chunk, c));
     }
 
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
+
     return SSD1306_OK;
 }
 
 enum ssd1306_err
 ssd1306_write_char(struct ssd1306_ctx *ctx, uint8_t c)
 {
-    const uint8_t *glyph = font8x8_basic[c];
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+    const uint8_t *glyph;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, c, &glyph));
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_write_data_list(ctx, glyph, (size_t)font->width * font->pages));
+
+    return SSD1306_OK;
+}
+
+/**
+ * Expands a page byte of a glyph by @c scale and returns one of the resulting
+ * page bytes.
+ *
+ * @param byte     page byte to expand
+ * @param scale    factor to expand @c byte by
+ * @param sub_page which of the @c scale resulting page bytes to return, from
+ *                 top to bottom
+ */
+static uint8_t
+expand_byte(uint8_t byte, uint8_t scale, uint8_t sub_page)
+{
+    if (scale == 1) {
+        return byte;
+    }
+
+    const uint16_t *expand = expand_nybble[scale - 2];
+    uint32_t expanded = expand[byte & 0x0F]
+                        | ((uint32_t)expand[byte >> 4] << (4 * scale));
+
+    return (uint8_t)(expanded >> (SSD1306_ROWS_PER_PAGE * sub_page));
+}
+
+/**
+ * Destination of the bytes produced by @ref emit_scaled. When @c dst is
+ * @c NULL, the bytes are streamed to the display through @c chunk.
+ */
+struct glyph_sink {
+    struct ssd1306_ctx *ctx;
+    struct ssd1306_data_chunk chunk;
+
+    uint8_t *dst;
+    size_t dst_len;
+    size_t len;
+};
+
+static enum ssd1306_err
+sink_put(struct glyph_sink *sink, uint8_t byte)
+{
+    if (sink->dst == NULL) {
+        return ssd1306_chunk_push(sink->ctx, &sink->chunk, byte);
+    }
+    else if (sink->len == sink->dst_len) {
+        return SSD1306_BUFFER_TOO_SMALL;
+    }
+
+    sink->dst[sink->len++] = byte;
+
+    return SSD1306_OK;
+}
+
+/**
+ * Produces the bytes of @c str scaled up by @c scale in the order
+ * @ref SSD1306_HORIZ_ADDR_MODE consumes them for a window that's exactly as
+ * big as the text.
+ *
+ * @c str doesn't need to be terminated since @ref ssd1306_write_char_scaled
+ * has to be able to write U+0000. Every glyph must be in @c font.
+ */
+static enum ssd1306_err
+emit_scaled(const struct ssd1306_font *font, const uint8_t *str,
+            size_t str_len, uint8_t scale, uint8_t xor_mask,
+            struct glyph_sink *sink)
+{
+    size_t pages = (size_t)font->pages * scale;
+
+    for (size_t dst_page = 0; dst_page < pages; dst_page++) {
+        size_t src_page = dst_page / scale;
+        uint8_t sub_page = dst_page % scale;
+
+        for (size_t i = 0; i < str_len; i++) {
+            const uint8_t *glyph;
+
+            SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, str[i], &glyph));
+
+            const uint8_t *cols = &glyph[src_page * font->width];
+
+            for (size_t x = 0; x < font->width; x++) {
+                uint8_t byte = expand_byte(cols[x], scale, sub_page) ^ xor_mask;
+
+                for (uint8_t n = 0; n < scale; n++) {
+                    SSD1306_RETURN_ON_ERR(sink_put(sink, byte));
+                }
+            }
+        }
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Checks the scale and makes sure every glyph of @c str is in @c font, so that
+ * a missing glyph doesn't leave half written output behind.
+ */
+static enum ssd1306_err
+check_scaled_str(const struct ssd1306_font *font, const uint8_t *str,
+                 size_t str_len, uint8_t scale)
+{
+    if (scale == 0 || scale > SSD1306_MAX_TEXT_SCALE) {
+        return SSD1306_SCALE_UNSUPPORTED;
+    }
+
+    for (size_t i = 0; i < str_len; i++) {
+        const uint8_t *glyph;
+
+        SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, str[i], &glyph));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Shared implementation of @ref ssd1306_write_str_scaled and
+ * @ref ssd1306_write_char_scaled.
+ */
+static enum ssd1306_err
+write_scaled(struct ssd1306_ctx *ctx, enum ssd1306_col col,
+             enum ssd1306_page page, const uint8_t *str, size_t str_len,
+             uint8_t scale)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+
+    SSD1306_RETURN_ON_ERR(check_scaled_str(font, str, str_len, scale));
+
+    if (str_len == 0) {
+        return SSD1306_OK;
+    }
+
+    size_t width = str_len * font->width * scale;
+    size_t pages = (size_t)font->pages * scale;
+
+    if (col + width > ctx->width
+        || (page + pages) * SSD1306_ROWS_PER_PAGE > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(ctx, col, col + width - 1));
+    SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(ctx, page, page + pages - 1));
+
+    struct glyph_sink sink = {.ctx = ctx, .chunk = {.len = 0}, .dst = NULL};
+
+    SSD1306_RETURN_ON_ERR(emit_scaled(font, str, str_len, scale, 0x00, &sink));
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &sink.chunk));
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_write_str_scaled(struct ssd1306_ctx *ctx, enum ssd1306_col col,
+                         enum ssd1306_page page, const uint8_t *str,
+                         uint8_t scale)
+{
+    if (str == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    return write_scaled(ctx, col, page, str, strlen((const char *)str), scale);
+}
+
+enum ssd1306_err
+ssd1306_write_char_scaled(struct ssd1306_ctx *ctx, enum ssd1306_col col,
+                          enum ssd1306_page page, uint8_t c, uint8_t scale)
+{
+    return write_scaled(ctx, col, page, &c, 1, scale);
+}
+
+enum ssd1306_err
+ssd1306_render_str_scaled(const struct ssd1306_font *font, const uint8_t *str,
+                          uint8_t scale, bool inverted, uint8_t *dst,
+                          size_t dst_len, size_t *rendered_len)
+{
+    if (font == NULL || str == NULL || dst == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    size_t str_len = strlen((const char *)str);
+
+    SSD1306_RETURN_ON_ERR(check_scaled_str(font, str, str_len, scale));
+
+    struct glyph_sink sink = {.dst = dst, .dst_len = dst_len, .len = 0};
+
+    SSD1306_RETURN_ON_ERR(emit_scaled(font, str, str_len, scale,
+                                      inverted ? 0xFF : 0x00, &sink));
+
+    *rendered_len = sink.len;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_transpose_font(const struct ssd1306_font *font, uint8_t *dst,
+                       size_t dst_len, struct ssd1306_font *transposed)
+{
+    if (font == NULL || dst == NULL || transposed == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (font->width % SSD1306_ROWS_PER_PAGE != 0) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    size_t glyph_len = (size_t)font->width * font->pages;
+    uint8_t width = (uint8_t)(font->pages * SSD1306_ROWS_PER_PAGE);
+    uint8_t pages = font->width / SSD1306_ROWS_PER_PAGE;
+
+    if (dst_len < glyph_len * font->num_glyphs) {
+        return SSD1306_BUFFER_TOO_SMALL;
+    }
+
+    /*
+     * Every 8x8 block of a glyph moves to the mirror position across the
+     * diagonal and is transposed itself.
+     */
+    for (size_t glyph = 0; glyph < font->num_glyphs; glyph++) {
+        const uint8_t *src = &font->glyphs[glyph * glyph_len];
+        uint8_t *out = &dst[glyph * glyph_len];
+
+        for (uint8_t page = 0; page < pages; page++) {
+            for (uint8_t src_page = 0; src_page < font->pages; src_page++) {
+                ssd1306_transpose_8x8(
+                    &src[src_page * font->width
+                         + page * SSD1306_ROWS_PER_PAGE],
+                    &out[page * width + src_page * SSD1306_ROWS_PER_PAGE]);
+            }
+        }
+    }
+
+    transposed->glyphs = dst;
+    transposed->width = width;
+    transposed->pages = pages;
+    transposed->first_char = font->first_char;
+    transposed->num_glyphs = font->num_glyphs;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_write_str_portrait(struct ssd1306_ctx *ctx,
+                           const struct ssd1306_font *font, uint8_t x,
+                           uint8_t page, const uint8_t *str)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (font == NULL || str == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* Transposed glyphs only come out upright on a rotated display. */
+    else if (!ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    size_t str_len = strlen((const char *)str);
+
+    SSD1306_RETURN_ON_ERR(check_scaled_str(font, str, str_len, 1));
+
+    if (str_len == 0) {
+        return SSD1306_OK;
+    }
+
+    /* Columns of the rotated screen are rows of the display and vice versa. */
+    size_t first_col = (size_t)page * SSD1306_ROWS_PER_PAGE;
+    size_t first_page = x / SSD1306_ROWS_PER_PAGE;
+    size_t pages = str_len * font->pages;
+
+    if (x % SSD1306_ROWS_PER_PAGE != 0 || first_col + font->width > ctx->width
+        || (first_page + pages) * SSD1306_ROWS_PER_PAGE > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(
+        ctx, (uint8_t)first_col, (uint8_t)(first_col + font->width - 1)));
+    SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(
+        ctx, (uint8_t)first_page, (uint8_t)(first_page + pages - 1)));
+
+    /* The window is as wide as a glyph, so each one is a contiguous run. */
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    for (size_t i = 0; i < str_len; i++) {
+        const uint8_t *glyph;
+
+        SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, str[i], &glyph));
+        SSD1306_RETURN_ON_ERR(ssd1306_chunk_push_list(
+            ctx, &chunk, glyph, (size_t)font->width * font->pages));
+    }
 
-    SSD1306_RETURN_ON_ERR(ssd1306_write_data_list(ctx, glyph, FONT_WIDTH));
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
 
     return SSD1306_OK;
 }
@@ -0,0 +1,342 @@
+#include "ssd1306/frame.h"
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include "window.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * Reset values of the timing registers.
+ */
+#define RESET_CLOCK       0x80
+#define RESET_PRECHARGE   0x22
+#define RESET_ACTIVE_ROWS 0x3F
+
+/**
+ * DCLKs of phase 3 (bank 0) of each row, fixed by the display.
+ */
+#define PHASE_3_DCLKS 50
+
+/**
+ * Typical oscillator frequency, in Hz, at setting 0 and its increase per
+ * setting, read off the F_osc vs. setting curve of the datasheet. The reset
+ * setting, 8, gives 370 kHz.
+ */
+#define OSC_BASE_HZ 175000U
+#define OSC_STEP_HZ 24375U
+
+/**
+ * How much of the measured period error a sync corrects, as a shift. Filters
+ * jitter in the time stamps passed in.
+ */
+#define PERIOD_GAIN_SHIFT 2
+
+/**
+ * Rows in the display's RAM.
+ */
+#define RAM_ROWS (SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE)
+
+static uint8_t
+timing_field(const struct ssd1306_ctx *ctx, enum ssd1306_timing_field field,
+             uint8_t value, uint8_t reset)
+{
+    return (ctx->timing.programmed & field) ? value : reset;
+}
+
+uint32_t
+ssd1306_frame_period_ns(const struct ssd1306_ctx *ctx)
+{
+    if (ctx == NULL) {
+        return 0;
+    }
+
+    uint8_t clock = timing_field(ctx, SSD1306_TIMING_CLOCK, ctx->timing.clock,
+                                 RESET_CLOCK);
+    uint8_t precharge = timing_field(ctx, SSD1306_TIMING_PRECHARGE,
+                                     ctx->timing.precharge, RESET_PRECHARGE);
+    uint8_t active_rows =
+        timing_field(ctx, SSD1306_TIMING_ACTIVE_ROWS, ctx->timing.active_rows,
+                     RESET_ACTIVE_ROWS);
+
+    uint64_t osc_hz = OSC_BASE_HZ + (uint64_t)(clock >> 4) * OSC_STEP_HZ;
+    uint64_t divide = (clock & 0xF) + 1U;
+    uint64_t dclks = (precharge & 0xF) + (precharge >> 4) + PHASE_3_DCLKS;
+    uint64_t mux = active_rows + 1U;
+
+    return (uint32_t)((divide * dclks * mux * 1000000000U + osc_hz / 2)
+                      / osc_hz);
+}
+
+enum ssd1306_err
+ssd1306_frame_clock_init(struct ssd1306_frame_clock *clock,
+                         const struct ssd1306_ctx *ctx,
+                         ssd1306_now_ns_cb now_ns,
+                         ssd1306_sleep_ns_cb sleep_ns, void *user)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (clock == NULL || now_ns == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    clock->now_ns = now_ns;
+    clock->sleep_ns = sleep_ns;
+    clock->user = user;
+    clock->period_ns = ssd1306_frame_period_ns(ctx);
+    clock->rows = (uint16_t)(timing_field(ctx, SSD1306_TIMING_ACTIVE_ROWS,
+                                          ctx->timing.active_rows,
+                                          RESET_ACTIVE_ROWS)
+                             + 1);
+    clock->frame_start_ns = now_ns(user);
+    clock->synced = false;
+
+    return SSD1306_OK;
+}
+
+void
+ssd1306_frame_clock_sync(struct ssd1306_frame_clock *clock,
+                         uint64_t frame_start_ns)
+{
+    if (clock->synced && frame_start_ns > clock->frame_start_ns) {
+        uint64_t elapsed = frame_start_ns - clock->frame_start_ns;
+        uint64_t frames = (elapsed + clock->period_ns / 2) / clock->period_ns;
+
+        if (frames != 0) {
+            int64_t error = (int64_t)(elapsed / frames) - clock->period_ns;
+
+            clock->period_ns =
+                (uint32_t)(clock->period_ns + error / (1 << PERIOD_GAIN_SHIFT));
+        }
+    }
+
+    clock->frame_start_ns = frame_start_ns;
+    clock->synced = true;
+}
+
+/**
+ * Returns how far into its frame the scan is at @c now_ns.
+ */
+static uint32_t
+frame_pos_ns(const struct ssd1306_frame_clock *clock, uint64_t now_ns)
+{
+    if (now_ns >= clock->frame_start_ns) {
+        return (uint32_t)((now_ns - clock->frame_start_ns) % clock->period_ns);
+    }
+
+    /* A sync from a time stamp taken after now_ns. */
+    uint32_t before =
+        (uint32_t)((clock->frame_start_ns - now_ns) % clock->period_ns);
+
+    return before == 0 ? 0 : clock->period_ns - before;
+}
+
+/**
+ * Returns the time, from the start of a frame, the scan reaches @c row at.
+ */
+static uint32_t
+row_start_ns(const struct ssd1306_frame_clock *clock, uint32_t row)
+{
+    return (uint32_t)((uint64_t)row * clock->period_ns / clock->rows);
+}
+
+uint16_t
+ssd1306_frame_clock_scan_row(const struct ssd1306_frame_clock *clock,
+                             uint64_t now_ns)
+{
+    return (uint16_t)((uint64_t)frame_pos_ns(clock, now_ns) * clock->rows
+                      / clock->period_ns);
+}
+
+uint32_t
+ssd1306_frame_clock_wait_ns(const struct ssd1306_frame_clock *clock,
+                            uint64_t now_ns, uint16_t first_row,
+                            uint16_t last_row, uint32_t write_ns)
+{
+    uint32_t period = clock->period_ns;
+    uint32_t band_start = row_start_ns(clock, first_row);
+    uint32_t band_end = row_start_ns(clock, last_row + 1U);
+    uint64_t busy = (uint64_t)(band_end - band_start) + write_ns;
+
+    if (busy >= period) {
+        return 0;
+    }
+
+    /*
+     * The write may start anywhere from the scan leaving the band to the
+     * latest time that still finishes before the scan comes back to it.
+     */
+    uint32_t slack = (uint32_t)(period - busy);
+    uint32_t since_band =
+        (frame_pos_ns(clock, now_ns) + period - band_end % period) % period;
+
+    if (since_band <= slack) {
+        return 0;
+    }
+
+    return period - since_band;
+}
+
+/**
+ * The scan a flush dodges: the clock it's timed with and the RAM row the
+ * start line puts on the first scan row.
+ */
+struct scan {
+    const struct ssd1306_frame_clock *clock;
+    uint8_t start_line;
+};
+
+/**
+ * Finds the scan rows pages @c first_page to @c last_page of RAM are shown
+ * on. RAM is a ring the start line rotates, so the rows shown after the scan
+ * wraps back to the top are returned as rows of the next frame, past
+ * @ref ssd1306_frame_clock::rows, and the band stays one stretch of time.
+ *
+ * @return @c false if none of the rows are shown
+ */
+static bool
+scan_band(const struct scan *scan, uint8_t first_page, uint8_t last_page,
+          uint16_t *first_row, uint16_t *last_row)
+{
+    uint16_t rows = scan->clock->rows;
+    uint16_t first =
+        (uint16_t)((first_page * SSD1306_ROWS_PER_PAGE + RAM_ROWS
+                    - scan->start_line)
+                   % RAM_ROWS);
+    uint16_t last = (uint16_t)(first
+                               + (last_page - first_page + 1)
+                                     * SSD1306_ROWS_PER_PAGE
+                               - 1);
+
+    /* RAM rows from the number of scan rows to the end of RAM aren't shown. */
+    *first_row = first < rows ? first : rows;
+
+    if (last < rows) {
+        *last_row = last;
+    }
+    else if (last < RAM_ROWS) {
+        *last_row = (uint16_t)(rows - 1);
+    }
+    else {
+        *last_row = (uint16_t)(last - RAM_ROWS + rows);
+    }
+
+    return *first_row <= *last_row;
+}
+
+/**
+ * Returns whether a window can be written without the scan passing through
+ * it. @c user is the @ref scan.
+ */
+static bool
+can_dodge_scan(const void *user, const struct ssd1306_window *window,
+               uint32_t write_ns)
+{
+    const struct scan *scan = user;
+    uint16_t first_row;
+    uint16_t last_row;
+
+    if (!scan_band(scan, window->first_page, window->last_page, &first_row,
+                   &last_row)) {
+        return true;
+    }
+
+    uint32_t band_ns = row_start_ns(scan->clock, last_row + 1U)
+                       - row_start_ns(scan->clock, first_row);
+
+    return (uint64_t)band_ns + write_ns < scan->clock->period_ns;
+}
+
+/**
+ * Waits until the window can be written.
+ */
+static void
+wait_for_scan(const struct scan *scan, uint8_t first_page, uint8_t last_page,
+              uint32_t write_ns)
+{
+    const struct ssd1306_frame_clock *clock = scan->clock;
+    uint16_t first_row;
+    uint16_t last_row;
+
+    if (!scan_band(scan, first_page, last_page, &first_row, &last_row)) {
+        return;
+    }
+
+    uint64_t now = clock->now_ns(clock->user);
+    uint32_t wait =
+        ssd1306_frame_clock_wait_ns(clock, now, first_row, last_row, write_ns);
+
+    if (wait == 0) {
+        return;
+    }
+    else if (clock->sleep_ns != NULL) {
+        clock->sleep_ns(clock->user, wait);
+        return;
+    }
+
+    while (clock->now_ns(clock->user) - now < wait) {
+        /* Spin. */
+    }
+}
+
+enum ssd1306_err
+ssd1306_frame_fb_flush(struct ssd1306_ctx *ctx,
+                       const struct ssd1306_frame_clock *clock,
+                       const struct ssd1306_bus_model *bus,
+                       struct ssd1306_fb *fb)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (clock == NULL || bus == NULL || fb == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+    else if (fb->width > ctx->width || fb->height > ctx->height
+             || fb->height > clock->rows) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    const struct scan scan = {clock, ctx->start_line};
+    const struct ssd1306_spans spans = {
+        .first = fb->dirty_first,
+        .last = fb->dirty_last,
+        .num_pages = (uint8_t)(fb->height / SSD1306_ROWS_PER_PAGE),
+        .width = fb->width,
+        .col_bytes = 1,
+    };
+    uint8_t page = 0;
+
+    while (page < spans.num_pages) {
+        if (!ssd1306_spans_is_dirty(&spans, page)) {
+            page++;
+            continue;
+        }
+
+        /* Windows only grow while the scan can still be dodged. */
+        struct ssd1306_window window;
+        uint32_t cost = ssd1306_window_grow(&spans, bus, page, can_dodge_scan,
+                                            &scan, &window);
+
+        wait_for_scan(&scan, window.first_page, window.last_page, cost);
+
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_window_write(ctx, fb->buf, fb->width, 0, &window));
+
+        page = window.last_page + 1;
+    }
+
+    ssd1306_fb_mark_clean(fb);
+
+    return ssd1306_resume_scrolling(ctx);
+}
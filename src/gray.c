@@ -0,0 +1,208 @@
+#include "ssd1306/gray.h"
+
+#include "ssd1306/bus.h"
+#include "ssd1306/canvas.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/shadow.h"
+#include "ssd1306/ssd1306.h"
+#include "ssd1306/transpose.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memset */
+
+/**
+ * Most bits per pixel, and so planes, a grayscale framebuffer can have.
+ */
+#define MAX_BPP 4
+
+static size_t
+plane_len(const struct ssd1306_gray_fb *gray)
+{
+    return SSD1306_FB_LEN(gray->width, gray->height);
+}
+
+static uint8_t
+max_level(const struct ssd1306_gray_fb *gray)
+{
+    return (uint8_t)((1U << gray->bpp) - 1);
+}
+
+enum ssd1306_err
+ssd1306_gray_init(struct ssd1306_gray_fb *gray, uint8_t *buf, uint16_t width,
+                  uint16_t height, uint8_t bpp)
+{
+    if (gray == NULL || buf == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (width == 0 || width > SSD1306_FB_MAX_WIDTH || height == 0
+             || height > SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE
+             || height % SSD1306_ROWS_PER_PAGE != 0) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+    else if (bpp != 2 && bpp != MAX_BPP) {
+        return SSD1306_DEPTH_UNSUPPORTED;
+    }
+
+    gray->buf = buf;
+    gray->width = width;
+    gray->height = height;
+    gray->bpp = bpp;
+
+    ssd1306_gray_clear(gray);
+
+    return SSD1306_OK;
+}
+
+void
+ssd1306_gray_clear(struct ssd1306_gray_fb *gray)
+{
+    memset(gray->buf, 0x00, plane_len(gray) * gray->bpp);
+}
+
+uint8_t *
+ssd1306_gray_plane(const struct ssd1306_gray_fb *gray, uint8_t plane)
+{
+    return &gray->buf[plane * plane_len(gray)];
+}
+
+void
+ssd1306_gray_set_pixel(struct ssd1306_gray_fb *gray, int16_t x, int16_t y,
+                       uint8_t level)
+{
+    if (x < 0 || x >= gray->width || y < 0 || y >= gray->height) {
+        return;
+    }
+
+    size_t offset = (size_t)(y / SSD1306_ROWS_PER_PAGE) * gray->width + x;
+    uint8_t bit = 1U << (y % SSD1306_ROWS_PER_PAGE);
+
+    if (level > max_level(gray)) {
+        level = max_level(gray);
+    }
+
+    for (uint8_t plane = 0; plane < gray->bpp; plane++) {
+        uint8_t *byte = &ssd1306_gray_plane(gray, plane)[offset];
+
+        if (level & (1U << plane)) {
+            *byte |= bit;
+        }
+        else {
+            *byte &= (uint8_t)~bit;
+        }
+    }
+}
+
+uint8_t
+ssd1306_gray_get_pixel(const struct ssd1306_gray_fb *gray, int16_t x,
+                       int16_t y)
+{
+    if (x < 0 || x >= gray->width || y < 0 || y >= gray->height) {
+        return 0;
+    }
+
+    size_t offset = (size_t)(y / SSD1306_ROWS_PER_PAGE) * gray->width + x;
+    uint8_t shift = y % SSD1306_ROWS_PER_PAGE;
+    uint8_t level = 0;
+
+    for (uint8_t plane = 0; plane < gray->bpp; plane++) {
+        uint8_t byte = ssd1306_gray_plane(gray, plane)[offset];
+
+        level |= (uint8_t)(((byte >> shift) & 1U) << plane);
+    }
+
+    return level;
+}
+
+void
+ssd1306_gray_load(struct ssd1306_gray_fb *gray, const uint8_t *src,
+                  size_t src_stride)
+{
+    /* A page's worth of row-major bits for each plane. */
+    uint8_t rows[MAX_BPP][SSD1306_ROWS_PER_PAGE]
+                [SSD1306_CANVAS_STRIDE(SSD1306_FB_MAX_WIDTH)];
+    uint8_t max = max_level(gray);
+
+    for (uint16_t page = 0; page < gray->height / SSD1306_ROWS_PER_PAGE;
+         page++) {
+        memset(rows, 0x00, sizeof(rows));
+
+        for (uint8_t r = 0; r < SSD1306_ROWS_PER_PAGE; r++) {
+            const uint8_t *line =
+                &src[(size_t)(page * SSD1306_ROWS_PER_PAGE + r) * src_stride];
+
+            for (uint16_t x = 0; x < gray->width; x++) {
+                uint8_t level =
+                    (uint8_t)((line[x] * max + UINT8_MAX / 2) / UINT8_MAX);
+
+                for (uint8_t plane = 0; plane < gray->bpp; plane++) {
+                    rows[plane][r][x / 8] |=
+                        (uint8_t)(((level >> plane) & 1U) << (x % 8));
+                }
+            }
+        }
+
+        /* Splitting by rows first lets the planes use the fast transpose. */
+        for (uint8_t plane = 0; plane < gray->bpp; plane++) {
+            ssd1306_rows_to_pages(&rows[plane][0][0], sizeof(rows[plane][0]),
+                                  gray->width, SSD1306_ROWS_PER_PAGE,
+                                  SSD1306_LSB_FIRST,
+                                  &ssd1306_gray_plane(gray, plane)
+                                      [(size_t)page * gray->width]);
+        }
+    }
+}
+
+enum ssd1306_err
+ssd1306_gray_sched_init(struct ssd1306_gray_sched *sched,
+                        const struct ssd1306_gray_fb *gray,
+                        struct ssd1306_shadow *shadow,
+                        const struct ssd1306_bus_model *bus, uint32_t slot_ns)
+{
+    if (sched == NULL || gray == NULL || shadow == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (shadow->width != gray->width || shadow->height != gray->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    sched->gray = gray;
+    sched->shadow = shadow;
+    sched->bus = bus;
+    sched->slot_ns = slot_ns;
+    /* The first tick moves on to plane 0. */
+    sched->plane = (uint8_t)(gray->bpp - 1);
+    sched->slots_left = 0;
+    sched->pending = false;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_gray_sched_tick(struct ssd1306_ctx *ctx,
+                        struct ssd1306_gray_sched *sched)
+{
+    bool done;
+
+    if (!sched->pending) {
+        if (sched->slots_left > 1) {
+            sched->slots_left--;
+            return SSD1306_OK;
+        }
+
+        sched->plane = (uint8_t)((sched->plane + 1) % sched->gray->bpp);
+        /* Plane k carries bit k of the level, so it's worth 2^k slots. */
+        sched->slots_left = (uint8_t)(1U << sched->plane);
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_shadow_flush(
+        ctx, sched->shadow, ssd1306_gray_plane(sched->gray, sched->plane),
+        sched->bus, sched->slot_ns, &done));
+
+    sched->pending = !done;
+
+    return SSD1306_OK;
+}
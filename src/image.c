@@ -0,0 +1,416 @@
+#include "ssd1306/image.h"
+
+#include "ssd1306/blit.h"
+#include "ssd1306/canvas.h"
+#include "ssd1306/dither.h"
+#include "ssd1306/err.h"
+#include "ssd1306/ssd1306.h"
+#include "ssd1306/transpose.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memcmp */
+
+/**
+ * Largest width and height an image can have. Bitmaps store them as
+ * @c uint16_t.
+ */
+#define MAX_DIMENSION UINT16_MAX
+
+/**
+ * Text being parsed.
+ */
+struct cursor {
+    const uint8_t *pos;
+    const uint8_t *end;
+};
+
+static bool
+is_space(uint8_t c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v'
+           || c == '\f';
+}
+
+static bool
+is_digit(uint8_t c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * Returns the value of a hex digit or -1 if @c c isn't one.
+ */
+static int
+hex_value(uint8_t c)
+{
+    if (is_digit(c)) {
+        return c - '0';
+    }
+    else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/**
+ * Skips whitespace and @c # comments, which run to the end of the line.
+ */
+static void
+skip_pnm_space(struct cursor *cur)
+{
+    while (cur->pos < cur->end) {
+        if (*cur->pos == '#') {
+            while (cur->pos < cur->end && *cur->pos != '\n') {
+                cur->pos++;
+            }
+        }
+        else if (is_space(*cur->pos)) {
+            cur->pos++;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+/**
+ * Parses a decimal number no greater than @c max.
+ */
+static bool
+parse_decimal(struct cursor *cur, unsigned long max, unsigned long *value)
+{
+    if (cur->pos == cur->end || !is_digit(*cur->pos)) {
+        return false;
+    }
+
+    *value = 0;
+
+    while (cur->pos < cur->end && is_digit(*cur->pos)) {
+        *value = *value * 10 + (unsigned long)(*cur->pos - '0');
+        cur->pos++;
+
+        if (*value > max) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Parses the header of a PBM or PGM. @c cur points right after the magic
+ * number.
+ */
+static enum ssd1306_err
+parse_pnm(struct cursor *cur, struct ssd1306_image *image)
+{
+    unsigned long width;
+    unsigned long height;
+    unsigned long maxval = 1;
+
+    skip_pnm_space(cur);
+
+    if (!parse_decimal(cur, MAX_DIMENSION, &width)) {
+        return SSD1306_IMAGE_MALFORMED;
+    }
+
+    skip_pnm_space(cur);
+
+    if (!parse_decimal(cur, MAX_DIMENSION, &height)) {
+        return SSD1306_IMAGE_MALFORMED;
+    }
+
+    if (image->format == SSD1306_IMAGE_PGM) {
+        skip_pnm_space(cur);
+
+        if (!parse_decimal(cur, UINT16_MAX, &maxval) || maxval == 0) {
+            return SSD1306_IMAGE_MALFORMED;
+        }
+    }
+
+    /* A single whitespace character separates the header from the raster. */
+    if (cur->pos == cur->end || !is_space(*cur->pos) || width == 0
+        || height == 0) {
+        return SSD1306_IMAGE_MALFORMED;
+    }
+
+    image->width = (uint16_t)width;
+    image->height = (uint16_t)height;
+    image->maxval = (uint16_t)maxval;
+    image->raster = cur->pos + 1;
+    image->raster_len = (size_t)(cur->end - image->raster);
+
+    return SSD1306_OK;
+}
+
+/**
+ * Moves @c cur right after the next occurrence of @c str.
+ */
+static bool
+find(struct cursor *cur, const char *str)
+{
+    size_t len = strlen(str);
+
+    for (; (size_t)(cur->end - cur->pos) >= len; cur->pos++) {
+        if (memcmp(cur->pos, str, len) == 0) {
+            cur->pos += len;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Parses the value of the @c #define whose name ends with @c suffix.
+ */
+static bool
+parse_xbm_define(struct cursor cur, const char *suffix, unsigned long *value)
+{
+    while (find(&cur, suffix)) {
+        /* Skip "_width" in "foo_width_hint" and the like. */
+        if (cur.pos == cur.end || !is_space(*cur.pos)) {
+            continue;
+        }
+
+        while (cur.pos < cur.end && is_space(*cur.pos)) {
+            cur.pos++;
+        }
+
+        return parse_decimal(&cur, MAX_DIMENSION, value) && *value != 0;
+    }
+
+    return false;
+}
+
+static enum ssd1306_err
+parse_xbm(struct cursor *cur, struct ssd1306_image *image)
+{
+    unsigned long width;
+    unsigned long height;
+
+    if (!parse_xbm_define(*cur, "_width", &width)
+        || !parse_xbm_define(*cur, "_height", &height) || !find(cur, "{")) {
+        return SSD1306_IMAGE_MALFORMED;
+    }
+
+    image->width = (uint16_t)width;
+    image->height = (uint16_t)height;
+    image->maxval = 1;
+    image->raster = cur->pos;
+    image->raster_len = (size_t)(cur->end - cur->pos);
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_image_parse(const uint8_t *data, size_t len,
+                    struct ssd1306_image *image)
+{
+    if (data == NULL || image == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    struct cursor cur = {data, data + len};
+
+    if (len >= 2 && data[0] == 'P' && (data[1] == '4' || data[1] == '5')) {
+        image->format =
+            data[1] == '4' ? SSD1306_IMAGE_PBM : SSD1306_IMAGE_PGM;
+        cur.pos += 2;
+
+        return parse_pnm(&cur, image);
+    }
+
+    image->format = SSD1306_IMAGE_XBM;
+
+    return parse_xbm(&cur, image);
+}
+
+/**
+ * Parses the next byte of an XBM's array: a hex number like @c 0x3c,
+ * followed by a comma or the closing brace.
+ */
+static bool
+parse_xbm_byte(struct cursor *cur, uint8_t *byte)
+{
+    while (cur->pos < cur->end && (is_space(*cur->pos) || *cur->pos == ',')) {
+        cur->pos++;
+    }
+
+    if (cur->end - cur->pos < 3 || cur->pos[0] != '0'
+        || (cur->pos[1] != 'x' && cur->pos[1] != 'X')) {
+        return false;
+    }
+
+    unsigned value = 0;
+    int digits = 0;
+
+    for (cur->pos += 2; cur->pos < cur->end && hex_value(*cur->pos) >= 0;
+         cur->pos++) {
+        value = value * 16 + (unsigned)hex_value(*cur->pos);
+
+        if (++digits > 2) {
+            return false;
+        }
+    }
+
+    *byte = (uint8_t)value;
+
+    return digits != 0;
+}
+
+static enum ssd1306_err
+xbm_to_bitmap(const struct ssd1306_image *image, uint8_t *dst)
+{
+    uint8_t rows[SSD1306_ROWS_PER_PAGE]
+                [SSD1306_CANVAS_STRIDE(SSD1306_IMAGE_MAX_WIDTH)];
+    size_t stride = SSD1306_CANVAS_STRIDE(image->width);
+    struct cursor cur = {image->raster, image->raster + image->raster_len};
+
+    for (size_t row = 0; row < image->height; row += SSD1306_ROWS_PER_PAGE) {
+        size_t num_rows = image->height - row < SSD1306_ROWS_PER_PAGE
+                              ? image->height - row
+                              : SSD1306_ROWS_PER_PAGE;
+
+        for (size_t r = 0; r < num_rows; r++) {
+            for (size_t i = 0; i < stride; i++) {
+                if (!parse_xbm_byte(&cur, &rows[r][i])) {
+                    return SSD1306_IMAGE_MALFORMED;
+                }
+            }
+        }
+
+        ssd1306_rows_to_pages(&rows[0][0], sizeof(rows[0]), image->width,
+                              (uint16_t)num_rows, SSD1306_LSB_FIRST,
+                              &dst[(row / SSD1306_ROWS_PER_PAGE)
+                                   * image->width]);
+    }
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+pgm_to_bitmap(const struct ssd1306_image *image, enum ssd1306_dither dither,
+              uint8_t *dst)
+{
+    struct ssd1306_ditherer ditherer;
+    uint8_t line[SSD1306_IMAGE_MAX_WIDTH];
+    size_t sample_len = image->maxval > UINT8_MAX ? 2 : 1;
+    size_t row_len = (size_t)image->width * sample_len;
+
+    if (image->raster_len / row_len < image->height) {
+        return SSD1306_IMAGE_MALFORMED;
+    }
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_ditherer_init(&ditherer, dither, image->width, 0, dst));
+
+    for (size_t row = 0; row < image->height; row++) {
+        const uint8_t *samples = &image->raster[row * row_len];
+
+        /* 8 bit samples up to white are dithered straight from the image. */
+        if (image->maxval == UINT8_MAX) {
+            ssd1306_ditherer_push_row(&ditherer, samples);
+            continue;
+        }
+
+        for (size_t x = 0; x < image->width; x++) {
+            /* 16 bit samples are big endian. */
+            unsigned long sample =
+                sample_len == 2
+                    ? (unsigned long)samples[2 * x] << 8 | samples[2 * x + 1]
+                    : samples[x];
+
+            if (sample > image->maxval) {
+                sample = image->maxval;
+            }
+
+            line[x] = (uint8_t)((sample * UINT8_MAX + image->maxval / 2)
+                                / image->maxval);
+        }
+
+        ssd1306_ditherer_push_row(&ditherer, line);
+    }
+
+    ssd1306_ditherer_finish(&ditherer);
+
+    return SSD1306_OK;
+}
+
+/**
+ * Turns every pixel of a bitmap on or off the other way round. Rows past
+ * @c height in the last page stay off.
+ */
+static void
+invert_bitmap(uint8_t *dst, uint16_t width, uint16_t height)
+{
+    size_t len = SSD1306_BITMAP_LEN(width, height);
+    size_t last_page = len - width;
+    uint8_t last_mask = height % SSD1306_ROWS_PER_PAGE == 0
+                            ? 0xFF
+                            : (uint8_t)((1U << (height % SSD1306_ROWS_PER_PAGE))
+                                        - 1);
+
+    for (size_t i = 0; i < last_page; i++) {
+        dst[i] = (uint8_t)~dst[i];
+    }
+
+    for (size_t i = last_page; i < len; i++) {
+        dst[i] = (uint8_t)(~dst[i] & last_mask);
+    }
+}
+
+enum ssd1306_err
+ssd1306_image_to_bitmap(const struct ssd1306_image *image,
+                        enum ssd1306_dither dither, bool inverted,
+                        uint8_t *dst, size_t len,
+                        struct ssd1306_bitmap *bitmap)
+{
+    if (image == NULL || dst == NULL || bitmap == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (len < SSD1306_BITMAP_LEN(image->width, image->height)) {
+        return SSD1306_BUFFER_TOO_SMALL;
+    }
+    else if (image->format != SSD1306_IMAGE_PBM
+             && image->width > SSD1306_IMAGE_MAX_WIDTH) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    switch (image->format) {
+        case SSD1306_IMAGE_PBM: {
+            size_t stride = SSD1306_CANVAS_STRIDE(image->width);
+
+            if (image->raster_len / stride < image->height) {
+                return SSD1306_IMAGE_MALFORMED;
+            }
+
+            ssd1306_rows_to_pages(image->raster, stride, image->width,
+                                  image->height, SSD1306_MSB_FIRST, dst);
+            break;
+        }
+        case SSD1306_IMAGE_PGM:
+            SSD1306_RETURN_ON_ERR(pgm_to_bitmap(image, dither, dst));
+            break;
+        default: /* SSD1306_IMAGE_XBM */
+            SSD1306_RETURN_ON_ERR(xbm_to_bitmap(image, dst));
+            break;
+    }
+
+    /* Set bits of the 1bpp formats are black, gray levels are bright. */
+    if ((image->format != SSD1306_IMAGE_PGM) != inverted) {
+        invert_bitmap(dst, image->width, image->height);
+    }
+
+    bitmap->data = dst;
+    bitmap->width = image->width;
+    bitmap->height = image->height;
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,166 @@
+#include "ssd1306/label_cache.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memcmp, memcpy, strlen */
+
+void
+ssd1306_label_cache_init(struct ssd1306_label_cache *cache,
+                         struct ssd1306_label_entry *entries,
+                         size_t num_entries)
+{
+    cache->entries = entries;
+    cache->num_entries = num_entries;
+
+    cache->clock = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+
+    ssd1306_label_cache_clear(cache);
+}
+
+void
+ssd1306_label_cache_clear(struct ssd1306_label_cache *cache)
+{
+    for (size_t i = 0; i < cache->num_entries; i++) {
+        cache->entries[i].valid = false;
+    }
+}
+
+static bool
+entry_matches(const struct ssd1306_label_entry *entry,
+              const struct ssd1306_font *font, const uint8_t *str,
+              size_t str_len, struct ssd1306_label_style style)
+{
+    return entry->valid && entry->font == font && entry->str_len == str_len
+           && entry->style.scale == style.scale
+           && entry->style.inverted == style.inverted
+           && memcmp(entry->str, str, str_len) == 0;
+}
+
+/**
+ * Finds the entry of a label or, if it isn't cached, the entry to render it
+ * into (an unused one if there is one, the least recently used otherwise).
+ *
+ * @return @c true on a hit
+ */
+static bool
+lookup(struct ssd1306_label_cache *cache, const struct ssd1306_font *font,
+       const uint8_t *str, size_t str_len, struct ssd1306_label_style style,
+       struct ssd1306_label_entry **found)
+{
+    struct ssd1306_label_entry *victim = &cache->entries[0];
+
+    for (size_t i = 0; i < cache->num_entries; i++) {
+        struct ssd1306_label_entry *entry = &cache->entries[i];
+
+        if (entry_matches(entry, font, str, str_len, style)) {
+            *found = entry;
+            return true;
+        }
+        else if (!victim->valid) {
+            continue;
+        }
+        else if (!entry->valid || entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+
+    *found = victim;
+
+    return false;
+}
+
+/**
+ * Renders a label into @c entry.
+ */
+static enum ssd1306_err
+fill_entry(struct ssd1306_label_entry *entry, const struct ssd1306_font *font,
+           const uint8_t *str, size_t str_len, struct ssd1306_label_style style)
+{
+    size_t rendered_len;
+
+    /* Invalidate first so a failed render doesn't leave a stale hit behind. */
+    entry->valid = false;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_render_str_scaled(
+        font, str, style.scale, style.inverted, entry->run,
+        SSD1306_ARRAY_LEN(entry->run), &rendered_len));
+
+    memcpy(entry->str, str, str_len);
+    entry->str_len = (uint8_t)str_len;
+    entry->font = font;
+    entry->style = style;
+
+    entry->cols = (uint16_t)(str_len * font->width * style.scale);
+    entry->pages = (uint8_t)(font->pages * style.scale);
+    entry->bytes = (uint16_t)rendered_len;
+    entry->valid = true;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_write_label(struct ssd1306_ctx *ctx, struct ssd1306_label_cache *cache,
+                    enum ssd1306_col col, enum ssd1306_page page,
+                    const uint8_t *str, struct ssd1306_label_style style)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (str == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    size_t str_len = strlen((const char *)str);
+
+    if (str_len == 0) {
+        return SSD1306_OK;
+    }
+    else if (str_len > SSD1306_LABEL_MAX_LEN || cache->num_entries == 0) {
+        return SSD1306_BUFFER_TOO_SMALL;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+    struct ssd1306_label_entry *entry;
+
+    if (lookup(cache, font, str, str_len, style, &entry)) {
+        cache->hits++;
+    }
+    else {
+        cache->misses++;
+
+        if (entry->valid) {
+            cache->evictions++;
+        }
+
+        SSD1306_RETURN_ON_ERR(fill_entry(entry, font, str, str_len, style));
+    }
+
+    entry->last_used = ++cache->clock;
+
+    if (col + entry->cols > ctx->width
+        || (page + entry->pages) * SSD1306_ROWS_PER_PAGE > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, col, col + entry->cols - 1));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, page, page + entry->pages - 1));
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_write_data_list(ctx, entry->run, entry->bytes));
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,142 @@
+#include "ssd1306/marquee.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * Writes the text's next @c cols columns to the right edge of the ticker.
+ */
+static enum ssd1306_err
+feed_cols(struct ssd1306_ctx *ctx, struct ssd1306_marquee *marquee,
+          uint16_t cols)
+{
+    const struct ssd1306_font *font = marquee->font;
+    uint32_t text_cols = (uint32_t)(marquee->len * font->width);
+    uint8_t last_page = (uint8_t)(marquee->first_page + font->pages - 1);
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(
+        ctx, (uint8_t)(ctx->width - cols), (uint8_t)(ctx->width - 1)));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, marquee->first_page, last_page));
+
+    for (uint8_t page = 0; page < font->pages; page++) {
+        uint32_t col = marquee->next_col;
+
+        for (uint16_t i = 0; i < cols; i++) {
+            const uint8_t *glyph;
+
+            /* Checked by ssd1306_marquee_init(). */
+            (void)ssd1306_find_glyph(font, marquee->text[col / font->width],
+                                     &glyph);
+
+            SSD1306_RETURN_ON_ERR(ssd1306_chunk_push(
+                ctx, &chunk, glyph[page * font->width + col % font->width]));
+
+            col = (col + 1) % text_cols;
+        }
+    }
+
+    marquee->next_col = (marquee->next_col + cols) % text_cols;
+
+    return ssd1306_chunk_flush(ctx, &chunk);
+}
+
+enum ssd1306_err
+ssd1306_marquee_init(struct ssd1306_ctx *ctx, struct ssd1306_marquee *marquee,
+                     const struct ssd1306_frame_clock *clock,
+                     enum ssd1306_page first_page,
+                     enum ssd1306_scroll_step interval, const uint8_t *text,
+                     size_t len)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (marquee == NULL || clock == NULL || text == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* The hardware scroll moves along the RAM's pages, not the screen's. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+
+    if (len == 0 || len > UINT32_MAX / font->width
+        || (first_page + font->pages) * SSD1306_ROWS_PER_PAGE > ctx->height) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        const uint8_t *glyph;
+
+        SSD1306_RETURN_ON_ERR(ssd1306_find_glyph(font, text[i], &glyph));
+    }
+
+    marquee->font = font;
+    marquee->text = text;
+    marquee->len = len;
+    marquee->first_page = first_page;
+    marquee->next_col = 0;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_stop_scrolling(ctx));
+    SSD1306_RETURN_ON_ERR(feed_cols(ctx, marquee, ctx->width));
+    SSD1306_RETURN_ON_ERR(ssd1306_scroll_left(
+        ctx, first_page, interval,
+        (enum ssd1306_page)(first_page + font->pages - 1)));
+
+    ctx->scroll.clock = clock;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_start_scrolling(ctx));
+
+    marquee->steps_fed = 0;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_marquee_tick(struct ssd1306_ctx *ctx, struct ssd1306_marquee *marquee)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (marquee == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    /* Flushes may have paused the scroll since, which the count allows for. */
+    uint32_t taken = ssd1306_scroll_steps(ctx);
+    uint32_t steps = taken - marquee->steps_fed;
+
+    if (steps == 0) {
+        return SSD1306_OK;
+    }
+
+    /* Columns that went by unseen are skipped. */
+    if (steps > ctx->width) {
+        uint32_t text_cols = (uint32_t)(marquee->len * marquee->font->width);
+
+        marquee->next_col = (uint32_t)(
+            (marquee->next_col + (steps - ctx->width)) % text_cols);
+        steps = ctx->width;
+    }
+
+    /* Each step wrapped the leftmost column around to the right edge. */
+    SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+    SSD1306_RETURN_ON_ERR(feed_cols(ctx, marquee, (uint16_t)steps));
+    SSD1306_RETURN_ON_ERR(ssd1306_resume_scrolling(ctx));
+
+    marquee->steps_fed = taken;
+
+    return SSD1306_OK;
+}
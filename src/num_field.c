@@ -0,0 +1,173 @@
+#include "ssd1306/num_field.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+enum ssd1306_err
+ssd1306_num_field_init(struct ssd1306_num_field *field, enum ssd1306_col col,
+                       enum ssd1306_page page, uint8_t len, uint8_t decimals,
+                       uint8_t scale, uint8_t pad)
+{
+    if (field == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (scale == 0 || scale > SSD1306_MAX_TEXT_SCALE) {
+        return SSD1306_SCALE_UNSUPPORTED;
+    }
+    /* Leave room for at least one digit before the decimal point. */
+    else if (len == 0 || len > SSD1306_NUM_FIELD_MAX_LEN
+             || (decimals != 0 && decimals + 2 > len)) {
+        return SSD1306_BUFFER_TOO_SMALL;
+    }
+
+    field->col = col;
+    field->page = page;
+    field->len = len;
+    field->decimals = decimals;
+    field->scale = scale;
+    field->pad = pad;
+    field->valid = false;
+
+    return SSD1306_OK;
+}
+
+void
+ssd1306_num_field_invalidate(struct ssd1306_num_field *field)
+{
+    field->valid = false;
+}
+
+/**
+ * Formats @c value right aligned into @c out, which is @c field->len
+ * characters long.
+ *
+ * @return @ref SSD1306_BUFFER_TOO_SMALL if @c value doesn't fit
+ */
+static enum ssd1306_err
+format(const struct ssd1306_num_field *field, int32_t value, uint8_t *out)
+{
+    bool negative = value < 0;
+    /* Negate as unsigned so INT32_MIN doesn't overflow. */
+    uint32_t magnitude = negative ? 0U - (uint32_t)value : (uint32_t)value;
+    int pos = field->len - 1;
+    /* Always print the integer digit, and every decimal. */
+    int min_digits = field->decimals + 1;
+    int digits = 0;
+
+    while (magnitude != 0 || digits < min_digits) {
+        if (pos < 0) {
+            return SSD1306_BUFFER_TOO_SMALL;
+        }
+
+        if (field->decimals != 0 && digits == field->decimals) {
+            out[pos--] = '.';
+
+            if (pos < 0) {
+                return SSD1306_BUFFER_TOO_SMALL;
+            }
+        }
+
+        out[pos--] = '0' + (magnitude % 10);
+        magnitude /= 10;
+        digits++;
+    }
+
+    if (field->pad == '0') {
+        /* The sign goes in front of the zeros, "-0042" not "00-42". */
+        int first = negative ? 1 : 0;
+
+        if (negative && pos < 0) {
+            return SSD1306_BUFFER_TOO_SMALL;
+        }
+
+        for (; pos >= first; pos--) {
+            out[pos] = '0';
+        }
+
+        if (negative) {
+            out[0] = '-';
+        }
+
+        return SSD1306_OK;
+    }
+
+    if (negative) {
+        if (pos < 0) {
+            return SSD1306_BUFFER_TOO_SMALL;
+        }
+
+        out[pos--] = '-';
+    }
+
+    for (; pos >= 0; pos--) {
+        out[pos] = field->pad;
+    }
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_num_field_update(struct ssd1306_ctx *ctx,
+                         struct ssd1306_num_field *field, int32_t value)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    const struct ssd1306_font *font = ssd1306_get_font(ctx);
+    size_t glyph_cols = (size_t)font->width * field->scale;
+    uint8_t next[SSD1306_NUM_FIELD_MAX_LEN];
+
+    SSD1306_RETURN_ON_ERR(format(field, value, next));
+
+    uint8_t i = 0;
+
+    while (i < field->len) {
+        if (field->valid && next[i] == field->shown[i]) {
+            i++;
+            continue;
+        }
+
+        /* Gather the run of changed characters, plus room for a '\0'. */
+        uint8_t run[SSD1306_NUM_FIELD_MAX_LEN + 1];
+        uint8_t start = i;
+        uint8_t run_len = 0;
+
+        while (i < field->len
+               && (!field->valid || next[i] != field->shown[i])) {
+            run[run_len++] = next[i++];
+        }
+
+        run[run_len] = '\0';
+
+        /*
+         * The field is only partially updated on failure, so make the next
+         * update redraw it from scratch.
+         */
+        enum ssd1306_err err = ssd1306_write_str_scaled(
+            ctx, field->col + start * glyph_cols, field->page, run,
+            field->scale);
+
+        if (err != SSD1306_OK) {
+            field->valid = false;
+            return err;
+        }
+
+        for (uint8_t j = 0; j < run_len; j++) {
+            field->shown[start + j] = run[j];
+        }
+    }
+
+    field->valid = true;
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,29 @@
+#include "page.h"
+
+#include "ssd1306/ssd1306.h"
+
+#include <stdint.h>
+
+int
+ssd1306_page_of_row(int row)
+{
+    return row >= 0 ? row / SSD1306_ROWS_PER_PAGE
+                    : -((-row + SSD1306_ROWS_PER_PAGE - 1)
+                        / SSD1306_ROWS_PER_PAGE);
+}
+
+uint8_t
+ssd1306_page_bits(int page, int first_row, int last_row)
+{
+    int top = page * SSD1306_ROWS_PER_PAGE;
+    int lo = first_row > top ? first_row : top;
+    int hi = last_row < top + SSD1306_ROWS_PER_PAGE - 1
+                 ? last_row
+                 : top + SSD1306_ROWS_PER_PAGE - 1;
+
+    if (lo > hi) {
+        return 0;
+    }
+
+    return (uint8_t)((0xFFU >> (7 - (hi - lo))) << (lo - top));
+}
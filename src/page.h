@@ -0,0 +1,32 @@
+/**
+ * @file
+ *
+ * Row and page arithmetic shared by the drawing modules. Internal to the
+ * library.
+ */
+
+#ifndef LIBSSD1306_SRC_PAGE_H
+#define LIBSSD1306_SRC_PAGE_H
+
+#include <stdint.h>
+
+/**
+ * Returns the page a row falls in. Unlike @c row / 8, rows above the buffer
+ * round towards negative infinity.
+ *
+ * @param row row, may be negative
+ */
+int ssd1306_page_of_row(int row);
+
+/**
+ * Returns the byte of @c page that has rows @c first_row to @c last_row set.
+ *
+ * @param page      page of the byte
+ * @param first_row first row to set
+ * @param last_row  last row to set
+ *
+ * @return the byte, 0 if none of the rows are in @c page
+ */
+uint8_t ssd1306_page_bits(int page, int first_row, int last_row);
+
+#endif /* LIBSSD1306_SRC_PAGE_H */
@@ -2,6 +2,7 @@
 #include "ssd1306/err.h"
 
 #include <stddef.h> /* size_t */
+#include <string.h> /* memcpy */
 
 #define BITU(n) (1U << (n))
 #define BIT(n)  BITU(n)
@@ -57,9 +58,15 @@ enum ssd1306_err
 ssd1306_send_cmd_list(struct ssd1306_ctx *ctx, const uint8_t *cmd_list,
                       size_t cmd_list_len)
 {
+    /* Don't want a segault when checking 'ssd1306_ctx::send_cmd_list'. */
+    SSD1306_RETURN_ON_ERR(check_ctx(ctx, CHECK_SEND_CMD));
+
     if (cmd_list == NULL) {
         return SSD1306_CMD_LIST_NULL;
     }
+    else if (ctx->send_cmd_list != NULL) {
+        return ctx->send_cmd_list(ctx, cmd_list, cmd_list_len);
+    }
 
     for (size_t i = 0; i < cmd_list_len; i++) {
         uint8_t cmd = cmd_list[i];
@@ -100,3 +107,61 @@ ssd1306_write_data_list(struct ssd1306_ctx *ctx, const uint8_t *data_list,
 
     return SSD1306_OK;
 }
+
+enum ssd1306_err
+ssd1306_chunk_flush(struct ssd1306_ctx *ctx, struct ssd1306_data_chunk *chunk)
+{
+    if (chunk->len == 0) {
+        return SSD1306_OK;
+    }
+
+    size_t len = chunk->len;
+
+    /* Empty the chunk even on failure so a retry doesn't resend stale data. */
+    chunk->len = 0;
+
+    return ssd1306_write_data_list(ctx, chunk->data, len);
+}
+
+enum ssd1306_err
+ssd1306_chunk_push(struct ssd1306_ctx *ctx, struct ssd1306_data_chunk *chunk,
+                   uint8_t data)
+{
+    if (chunk->len == SSD1306_ARRAY_LEN(chunk->data)) {
+        SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, chunk));
+    }
+
+    chunk->data[chunk->len++] = data;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_chunk_push_list(struct ssd1306_ctx *ctx,
+                        struct ssd1306_data_chunk *chunk,
+                        const uint8_t *data_list, size_t data_list_len)
+{
+    if (data_list == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    while (data_list_len != 0) {
+        size_t room = SSD1306_ARRAY_LEN(chunk->data) - chunk->len;
+
+        if (room == 0) {
+            SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, chunk));
+            continue;
+        }
+        else if (room > data_list_len) {
+            room = data_list_len;
+        }
+
+        memcpy(&chunk->data[chunk->len], data_list, room);
+
+        chunk->len += room;
+        data_list += room;
+        data_list_len -= room;
+    }
+
+    return SSD1306_OK;
+}
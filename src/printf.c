@@ -0,0 +1,404 @@
+#include "ssd1306/printf.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <limits.h> /* ULONG_MAX */
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * Most digits @c f prints after the decimal point.
+ */
+#define MAX_PRECISION 9
+
+/**
+ * Enough room for the digits of an unsigned long in octal or higher bases, a
+ * decimal point and @ref MAX_PRECISION decimals.
+ */
+#define MAX_BODY_LEN (sizeof(unsigned long) * CHAR_BIT / 3 + 2 + MAX_PRECISION)
+
+/**
+ * A parsed conversion specification.
+ */
+struct spec {
+    bool left;      /**< '-' flag */
+    bool zero;      /**< '0' flag */
+    bool plus;      /**< '+' flag */
+    bool is_long;   /**< 'l' length modifier */
+    size_t width;   /**< minimum width, 0 when absent */
+    int precision;  /**< -1 when absent */
+};
+
+/**
+ * Where the formatted characters go. Every character is turned into its glyph
+ * right away and batched in @c chunk.
+ */
+struct out {
+    struct ssd1306_ctx *ctx;
+    struct ssd1306_data_chunk chunk;
+};
+
+static enum ssd1306_err
+put(struct out *out, uint8_t c)
+{
+    return ssd1306_emit_char(out->ctx, &out->chunk, c);
+}
+
+static enum ssd1306_err
+put_repeated(struct out *out, uint8_t c, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        SSD1306_RETURN_ON_ERR(put(out, c));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Writes a converted argument, padded to the width of @c spec.
+ *
+ * @param out      where to write the field
+ * @param spec     conversion specification of the field
+ * @param sign     sign or @c '\0' for none
+ * @param body     characters of the field that follow the sign
+ * @param body_len length of @c body
+ * @param numeric  whether the @c '0' flag applies to this field
+ */
+static enum ssd1306_err
+put_field(struct out *out, const struct spec *spec, uint8_t sign,
+          const uint8_t *body, size_t body_len, bool numeric)
+{
+    size_t len = body_len + (sign != '\0');
+    size_t pad = spec->width > len ? spec->width - len : 0;
+    bool zero_pad = spec->zero && numeric && !spec->left;
+
+    if (!spec->left && !zero_pad) {
+        SSD1306_RETURN_ON_ERR(put_repeated(out, ' ', pad));
+    }
+
+    if (sign != '\0') {
+        SSD1306_RETURN_ON_ERR(put(out, sign));
+    }
+
+    if (zero_pad) {
+        SSD1306_RETURN_ON_ERR(put_repeated(out, '0', pad));
+    }
+
+    for (size_t i = 0; i < body_len; i++) {
+        SSD1306_RETURN_ON_ERR(put(out, body[i]));
+    }
+
+    if (spec->left) {
+        SSD1306_RETURN_ON_ERR(put_repeated(out, ' ', pad));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Converts @c value to digits, most significant first.
+ *
+ * @param value      value to convert
+ * @param base       10 or 16
+ * @param upper      use upper case hex digits
+ * @param min_digits pad with leading zeros up to this many digits
+ * @param digits     buffer of at least @ref MAX_BODY_LEN bytes
+ *
+ * @return number of digits placed in @c digits
+ */
+static size_t
+format_ulong(unsigned long value, unsigned base, bool upper, size_t min_digits,
+             uint8_t *digits)
+{
+    const char *symbols = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    size_t len = 0;
+
+    do {
+        digits[len++] = symbols[value % base];
+        value /= base;
+    } while (value != 0 || len < min_digits);
+
+    for (size_t i = 0; i < len / 2; i++) {
+        uint8_t tmp = digits[i];
+
+        digits[i] = digits[len - 1 - i];
+        digits[len - 1 - i] = tmp;
+    }
+
+    return len;
+}
+
+static enum ssd1306_err
+put_signed(struct out *out, const struct spec *spec, long value)
+{
+    uint8_t body[MAX_BODY_LEN];
+    uint8_t sign = value < 0 ? '-' : spec->plus ? '+' : '\0';
+    /* Negate as unsigned so LONG_MIN doesn't overflow. */
+    unsigned long magnitude =
+        value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
+    size_t len = format_ulong(magnitude, 10, false, 1, body);
+
+    return put_field(out, spec, sign, body, len, true);
+}
+
+static enum ssd1306_err
+put_unsigned(struct out *out, const struct spec *spec, unsigned long value,
+             unsigned base, bool upper)
+{
+    uint8_t body[MAX_BODY_LEN];
+    size_t len = format_ulong(value, base, upper, 1, body);
+
+    return put_field(out, spec, '\0', body, len, true);
+}
+
+static enum ssd1306_err
+put_fixed(struct out *out, const struct spec *spec, double value)
+{
+    static const unsigned long pow10[MAX_PRECISION + 1] = {
+        1UL,      10UL,      100UL,      1000UL,      10000UL,
+        100000UL, 1000000UL, 10000000UL, 100000000UL, 1000000000UL,
+    };
+
+    if (spec->precision > MAX_PRECISION) {
+        return SSD1306_FORMAT_UNSUPPORTED;
+    }
+    else if (value != value) {
+        return put_field(out, spec, '\0', (const uint8_t *)"nan", 3, false);
+    }
+
+    uint8_t sign = value < 0 ? '-' : spec->plus ? '+' : '\0';
+    size_t precision = spec->precision < 0 ? 6 : (size_t)spec->precision;
+
+    if (value < 0) {
+        value = -value;
+    }
+
+    if (value >= (double)ULONG_MAX) {
+        return put_field(out, spec, sign, (const uint8_t *)"ovf", 3, false);
+    }
+
+    unsigned long int_part = (unsigned long)value;
+    unsigned long frac_part =
+        (unsigned long)((value - int_part) * pow10[precision] + 0.5);
+
+    /*
+     * Rounding the decimals can carry into the integer part (9.999 -> 10.00).
+     */
+    if (frac_part >= pow10[precision]) {
+        frac_part -= pow10[precision];
+        int_part++;
+    }
+
+    uint8_t body[MAX_BODY_LEN];
+    size_t len = format_ulong(int_part, 10, false, 1, body);
+
+    if (precision != 0) {
+        body[len++] = '.';
+        len += format_ulong(frac_part, 10, false, precision, &body[len]);
+    }
+
+    return put_field(out, spec, sign, body, len, true);
+}
+
+static enum ssd1306_err
+put_str(struct out *out, const struct spec *spec, const char *str)
+{
+    if (str == NULL) {
+        str = "(null)";
+    }
+
+    size_t len = 0;
+
+    /* The precision caps the number of characters printed. */
+    while (str[len] != '\0'
+           && (spec->precision < 0 || len < (size_t)spec->precision)) {
+        len++;
+    }
+
+    return put_field(out, spec, '\0', (const uint8_t *)str, len, false);
+}
+
+/**
+ * Parses a run of decimal digits.
+ */
+static size_t
+parse_uint(const char **fmt)
+{
+    size_t value = 0;
+
+    while (**fmt >= '0' && **fmt <= '9') {
+        value = value * 10 + (size_t)(**fmt - '0');
+        (*fmt)++;
+    }
+
+    return value;
+}
+
+/**
+ * Parses a conversion specification. @c fmt points right after the @c '%' and
+ * is left pointing at the conversion character.
+ */
+static void
+parse_spec(const char **fmt, va_list *args, struct spec *spec)
+{
+    *spec = (struct spec){.precision = -1};
+
+    for (;; (*fmt)++) {
+        if (**fmt == '-') {
+            spec->left = true;
+        }
+        else if (**fmt == '0') {
+            spec->zero = true;
+        }
+        else if (**fmt == '+') {
+            spec->plus = true;
+        }
+        else {
+            break;
+        }
+    }
+
+    if (**fmt == '*') {
+        int width = va_arg(*args, int);
+
+        /* A negative width is a '-' flag followed by a positive width. */
+        if (width < 0) {
+            spec->left = true;
+            width = -width;
+        }
+
+        spec->width = (size_t)width;
+        (*fmt)++;
+    }
+    else {
+        spec->width = parse_uint(fmt);
+    }
+
+    if (**fmt == '.') {
+        (*fmt)++;
+
+        if (**fmt == '*') {
+            int precision = va_arg(*args, int);
+
+            spec->precision = precision < 0 ? -1 : precision;
+            (*fmt)++;
+        }
+        else {
+            size_t precision = parse_uint(fmt);
+
+            /* Anything past UINT8_MAX is way past what any conversion uses. */
+            spec->precision =
+                precision > UINT8_MAX ? UINT8_MAX : (int)precision;
+        }
+    }
+
+    if (**fmt == 'l') {
+        spec->is_long = true;
+        (*fmt)++;
+    }
+}
+
+/**
+ * Formats everything in @c fmt into @c out.
+ */
+static enum ssd1306_err
+format(struct out *out, const char *fmt, va_list *args)
+{
+    for (; *fmt != '\0'; fmt++) {
+        if (*fmt != '%') {
+            SSD1306_RETURN_ON_ERR(put(out, (uint8_t)*fmt));
+            continue;
+        }
+
+        struct spec spec;
+
+        fmt++;
+        parse_spec(&fmt, args, &spec);
+
+        switch (*fmt) {
+            case 'd':
+            case 'i':
+                SSD1306_RETURN_ON_ERR(put_signed(
+                    out, &spec,
+                    spec.is_long ? va_arg(*args, long) : va_arg(*args, int)));
+                break;
+            case 'u':
+            case 'x':
+            case 'X': {
+                unsigned long value = spec.is_long
+                                          ? va_arg(*args, unsigned long)
+                                          : va_arg(*args, unsigned);
+
+                SSD1306_RETURN_ON_ERR(put_unsigned(
+                    out, &spec, value, *fmt == 'u' ? 10 : 16, *fmt == 'X'));
+                break;
+            }
+            case 'f':
+                SSD1306_RETURN_ON_ERR(
+                    put_fixed(out, &spec, va_arg(*args, double)));
+                break;
+            case 'c': {
+                uint8_t c = (uint8_t)va_arg(*args, int);
+
+                SSD1306_RETURN_ON_ERR(
+                    put_field(out, &spec, '\0', &c, 1, false));
+                break;
+            }
+            case 's':
+                SSD1306_RETURN_ON_ERR(
+                    put_str(out, &spec, va_arg(*args, const char *)));
+                break;
+            case '%':
+                SSD1306_RETURN_ON_ERR(put(out, '%'));
+                break;
+            default:
+                return SSD1306_FORMAT_UNSUPPORTED;
+        }
+    }
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_vprintf(struct ssd1306_ctx *ctx, const char *fmt, va_list args)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (fmt == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    struct out out = {.ctx = ctx, .chunk = {.len = 0}};
+    va_list args_copy;
+
+    /* va_list can be an array type, so only ever pass a pointer to a copy. */
+    va_copy(args_copy, args);
+    enum ssd1306_err err = format(&out, fmt, &args_copy);
+    va_end(args_copy);
+
+    /* Whatever was formatted before an error still makes it to the display. */
+    enum ssd1306_err flush_err = ssd1306_chunk_flush(ctx, &out.chunk);
+
+    return err != SSD1306_OK ? err : flush_err;
+}
+
+enum ssd1306_err
+ssd1306_printf(struct ssd1306_ctx *ctx, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    enum ssd1306_err err = ssd1306_vprintf(ctx, fmt, args);
+    va_end(args);
+
+    return err;
+}
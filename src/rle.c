@@ -0,0 +1,455 @@
+#include "ssd1306/rle.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memcpy, memset */
+
+/**
+ * Longest run a single @ref SSD1306_RLE_ZEROS, @ref SSD1306_RLE_ONES or
+ * @ref SSD1306_RLE_LITERAL operation can describe.
+ */
+#define MAX_COUNT (SSD1306_RLE_COUNT_MASK + 1)
+
+/**
+ * Longest run a single @ref SSD1306_RLE_REPEAT operation can describe. Repeats
+ * are never shorter than 2 bytes so the count is biased by 2 instead of 1.
+ */
+#define MAX_REPEAT (SSD1306_RLE_COUNT_MASK + 2)
+
+void
+ssd1306_rle_decoder_init(struct ssd1306_rle_decoder *dec, const uint8_t *src,
+                         size_t src_len)
+{
+    dec->src = src;
+    dec->src_len = src_len;
+    dec->pos = 0;
+
+    dec->op = SSD1306_RLE_LITERAL;
+    dec->value = 0x00;
+    dec->remaining = 0;
+}
+
+/**
+ * Reads the next control byte (and its payload, for repeats) from the stream.
+ *
+ * The caller must make sure there is at least one unread byte left.
+ */
+static enum ssd1306_err
+fetch_op(struct ssd1306_rle_decoder *dec)
+{
+    uint8_t ctrl = dec->src[dec->pos++];
+    uint8_t count = ctrl & SSD1306_RLE_COUNT_MASK;
+
+    dec->op = ctrl & SSD1306_RLE_OP_MASK;
+
+    switch (dec->op) {
+        case SSD1306_RLE_LITERAL:
+            dec->remaining = count + 1;
+
+            if (dec->src_len - dec->pos < dec->remaining) {
+                return SSD1306_RLE_TRUNCATED;
+            }
+            break;
+        case SSD1306_RLE_ZEROS:
+            dec->value = 0x00;
+            dec->remaining = count + 1;
+            break;
+        case SSD1306_RLE_ONES:
+            dec->value = 0xFF;
+            dec->remaining = count + 1;
+            break;
+        default: /* SSD1306_RLE_REPEAT */
+            if (dec->pos == dec->src_len) {
+                return SSD1306_RLE_TRUNCATED;
+            }
+
+            dec->value = dec->src[dec->pos++];
+            dec->remaining = count + 2;
+            break;
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Shared loop of @ref ssd1306_rle_decode and @ref ssd1306_rle_skip. Passing in
+ * a @c NULL @c out throws the decoded bytes away.
+ */
+static enum ssd1306_err
+decode(struct ssd1306_rle_decoder *dec, uint8_t *out, size_t out_len,
+       size_t *decoded_len)
+{
+    size_t produced = 0;
+
+    while (produced < out_len) {
+        if (dec->remaining == 0) {
+            if (dec->pos == dec->src_len) {
+                break;
+            }
+
+            SSD1306_RETURN_ON_ERR(fetch_op(dec));
+        }
+
+        size_t n = out_len - produced;
+
+        if (n > dec->remaining) {
+            n = dec->remaining;
+        }
+
+        if (dec->op == SSD1306_RLE_LITERAL) {
+            if (out != NULL) {
+                memcpy(&out[produced], &dec->src[dec->pos], n);
+            }
+
+            dec->pos += n;
+        }
+        else if (out != NULL) {
+            memset(&out[produced], dec->value, n);
+        }
+
+        dec->remaining -= n;
+        produced += n;
+    }
+
+    *decoded_len = produced;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_rle_decode(struct ssd1306_rle_decoder *dec, uint8_t *out,
+                   size_t out_len, size_t *decoded_len)
+{
+    return decode(dec, out, out_len, decoded_len);
+}
+
+enum ssd1306_err
+ssd1306_rle_skip(struct ssd1306_rle_decoder *dec, size_t count)
+{
+    size_t skipped;
+
+    SSD1306_RETURN_ON_ERR(decode(dec, NULL, count, &skipped));
+
+    if (skipped != count) {
+        return SSD1306_RLE_TRUNCATED;
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Output side of the encoder. When @c dst is @c NULL, bytes are only counted.
+ */
+struct encoder {
+    uint8_t *dst;
+    size_t dst_len;
+    size_t len;
+};
+
+static enum ssd1306_err
+emit(struct encoder *enc, uint8_t byte)
+{
+    if (enc->dst != NULL) {
+        if (enc->len == enc->dst_len) {
+            return SSD1306_BUFFER_TOO_SMALL;
+        }
+
+        enc->dst[enc->len] = byte;
+    }
+
+    enc->len++;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+emit_literal(struct encoder *enc, const uint8_t *literal, size_t literal_len)
+{
+    if (literal_len == 0) {
+        return SSD1306_OK;
+    }
+
+    SSD1306_RETURN_ON_ERR(emit(enc, SSD1306_RLE_LITERAL | (literal_len - 1)));
+
+    for (size_t i = 0; i < literal_len; i++) {
+        SSD1306_RETURN_ON_ERR(emit(enc, literal[i]));
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Counts how many times @c src[0] repeats, up to @c max.
+ */
+static size_t
+run_len(const uint8_t *src, size_t src_len, size_t max)
+{
+    size_t len = 1;
+
+    if (max > src_len) {
+        max = src_len;
+    }
+
+    while (len < max && src[len] == src[0]) {
+        len++;
+    }
+
+    return len;
+}
+
+static bool
+is_blank_or_solid(uint8_t byte)
+{
+    return byte == 0x00 || byte == 0xFF;
+}
+
+enum ssd1306_err
+ssd1306_rle_encode(const uint8_t *src, size_t src_len, uint8_t *dst,
+                   size_t dst_len, size_t *encoded_len)
+{
+    if (src == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    struct encoder enc = {.dst = dst, .dst_len = dst_len, .len = 0};
+    size_t literal_start = 0;
+    size_t literal_len = 0;
+    size_t i = 0;
+
+    while (i < src_len) {
+        uint8_t byte = src[i];
+        bool blank_or_solid = is_blank_or_solid(byte);
+        size_t run = run_len(&src[i], src_len - i,
+                             blank_or_solid ? MAX_COUNT : MAX_REPEAT);
+
+        /*
+         * A lone 0x00/0xFF costs as much as a literal byte but would split the
+         * literal in two, and a repeat of 2 costs as much as the literal.
+         */
+        if ((blank_or_solid && run >= 2) || run >= 3) {
+            SSD1306_RETURN_ON_ERR(
+                emit_literal(&enc, &src[literal_start], literal_len));
+            literal_len = 0;
+
+            if (byte == 0x00) {
+                SSD1306_RETURN_ON_ERR(
+                    emit(&enc, SSD1306_RLE_ZEROS | (run - 1)));
+            }
+            else if (byte == 0xFF) {
+                SSD1306_RETURN_ON_ERR(
+                    emit(&enc, SSD1306_RLE_ONES | (run - 1)));
+            }
+            else {
+                SSD1306_RETURN_ON_ERR(
+                    emit(&enc, SSD1306_RLE_REPEAT | (run - 2)));
+                SSD1306_RETURN_ON_ERR(emit(&enc, byte));
+            }
+
+            i += run;
+            continue;
+        }
+
+        if (literal_len == 0) {
+            literal_start = i;
+        }
+
+        literal_len++;
+        i++;
+
+        if (literal_len == MAX_COUNT) {
+            SSD1306_RETURN_ON_ERR(
+                emit_literal(&enc, &src[literal_start], literal_len));
+            literal_len = 0;
+        }
+    }
+
+    SSD1306_RETURN_ON_ERR(emit_literal(&enc, &src[literal_start], literal_len));
+
+    *encoded_len = enc.len;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_rle_encode_font(const struct ssd1306_font *font,
+                        uint8_t glyphs_per_block, uint8_t *dst, size_t dst_len,
+                        uint16_t *block_offsets,
+                        struct ssd1306_rle_font *rle_font)
+{
+    if (font == NULL || dst == NULL || block_offsets == NULL
+        || rle_font == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (glyphs_per_block == 0) {
+        return SSD1306_BUFFER_TOO_SMALL;
+    }
+
+    size_t glyph_len = (size_t)font->width * font->pages;
+    size_t offset = 0;
+    size_t block = 0;
+
+    for (size_t glyph = 0; glyph < font->num_glyphs;
+         glyph += glyphs_per_block, block++) {
+        size_t num_glyphs = font->num_glyphs - glyph;
+        size_t encoded_len;
+
+        if (num_glyphs > glyphs_per_block) {
+            num_glyphs = glyphs_per_block;
+        }
+
+        block_offsets[block] = (uint16_t)offset;
+
+        SSD1306_RETURN_ON_ERR(ssd1306_rle_encode(
+            &font->glyphs[glyph * glyph_len], num_glyphs * glyph_len,
+            &dst[offset], dst_len - offset, &encoded_len));
+
+        offset += encoded_len;
+
+        if (offset > UINT16_MAX) {
+            return SSD1306_BUFFER_TOO_SMALL;
+        }
+    }
+
+    block_offsets[block] = (uint16_t)offset;
+
+    /* The index costs flash too, and with small blocks it eats the savings. */
+    if (offset + (block + 1) * sizeof(block_offsets[0])
+        >= font->num_glyphs * glyph_len) {
+        return SSD1306_RLE_NOT_SMALLER;
+    }
+
+    rle_font->data = dst;
+    rle_font->block_offsets = block_offsets;
+    rle_font->num_glyphs = font->num_glyphs;
+    rle_font->width = font->width;
+    rle_font->pages = font->pages;
+    rle_font->first_char = font->first_char;
+    rle_font->glyphs_per_block = glyphs_per_block;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_write_rle(struct ssd1306_ctx *ctx, const uint8_t *rle, size_t rle_len)
+{
+    if (rle == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    struct ssd1306_rle_decoder dec;
+    uint8_t chunk[SSD1306_DATA_CHUNK_LEN];
+    size_t chunk_len;
+
+    ssd1306_rle_decoder_init(&dec, rle, rle_len);
+
+    do {
+        SSD1306_RETURN_ON_ERR(ssd1306_rle_decode(
+            &dec, chunk, SSD1306_ARRAY_LEN(chunk), &chunk_len));
+
+        if (chunk_len != 0) {
+            SSD1306_RETURN_ON_ERR(
+                ssd1306_write_data_list(ctx, chunk, chunk_len));
+        }
+    } while (chunk_len == SSD1306_ARRAY_LEN(chunk));
+
+    return SSD1306_OK;
+}
+
+/**
+ * Decodes the glyph of @c c into @c chunk, writing the chunk out whenever it
+ * fills up.
+ */
+static enum ssd1306_err
+emit_rle_glyph(struct ssd1306_ctx *ctx, const struct ssd1306_rle_font *font,
+               uint8_t c, struct ssd1306_data_chunk *chunk)
+{
+    if (c < font->first_char || c - font->first_char >= font->num_glyphs) {
+        return SSD1306_GLYPH_NOT_IN_FONT;
+    }
+
+    size_t glyph = c - font->first_char;
+    size_t block = glyph / font->glyphs_per_block;
+    size_t glyph_len = (size_t)font->width * font->pages;
+    uint16_t block_start = font->block_offsets[block];
+    uint16_t block_end = font->block_offsets[block + 1];
+    struct ssd1306_rle_decoder dec;
+
+    ssd1306_rle_decoder_init(&dec, &font->data[block_start],
+                             block_end - block_start);
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_rle_skip(&dec, (glyph % font->glyphs_per_block) * glyph_len));
+
+    while (glyph_len != 0) {
+        size_t room = SSD1306_ARRAY_LEN(chunk->data) - chunk->len;
+        size_t decoded_len;
+
+        if (room == 0) {
+            SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, chunk));
+            continue;
+        }
+        else if (room > glyph_len) {
+            room = glyph_len;
+        }
+
+        SSD1306_RETURN_ON_ERR(ssd1306_rle_decode(
+            &dec, &chunk->data[chunk->len], room, &decoded_len));
+
+        if (decoded_len != room) {
+            return SSD1306_RLE_TRUNCATED;
+        }
+
+        chunk->len += decoded_len;
+        glyph_len -= decoded_len;
+    }
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_write_rle_char(struct ssd1306_ctx *ctx,
+                       const struct ssd1306_rle_font *font, uint8_t c)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    /* Glyphs are laid out for landscape, like ssd1306_write_char's. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    SSD1306_RETURN_ON_ERR(emit_rle_glyph(ctx, font, c, &chunk));
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_write_rle_str(struct ssd1306_ctx *ctx,
+                      const struct ssd1306_rle_font *font, const uint8_t *str)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    for (; *str != '\0'; str++) {
+        SSD1306_RETURN_ON_ERR(emit_rle_glyph(ctx, font, *str, &chunk));
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_chunk_flush(ctx, &chunk));
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,305 @@
+#include "ssd1306/scale.h"
+
+#include "ssd1306/dither.h"
+#include "ssd1306/err.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memset */
+
+#if !defined(SSD1306_NO_SIMD) && defined(__SSE2__)
+#define SCALE_SSE2
+#include <emmintrin.h>
+#elif !defined(SSD1306_NO_SIMD) && defined(__ARM_NEON)
+#define SCALE_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(SSD1306_HAVE_PTHREADS)
+#include <pthread.h>
+#endif
+
+/**
+ * Most source rows a box filter averages into an output row. 257 rows of
+ * white add up to the largest value a 16 bit sum holds.
+ */
+#define MAX_BOX_ROWS (UINT16_MAX / UINT8_MAX)
+
+/**
+ * Most threads @ref ssd1306_downscale_parallel uses. One per page of a
+ * 64 row display.
+ */
+#define MAX_THREADS 8
+
+static uint16_t
+output_pages(const struct ssd1306_downscale *job)
+{
+    return (uint16_t)((job->height + SSD1306_ROWS_PER_PAGE - 1)
+                      / SSD1306_ROWS_PER_PAGE);
+}
+
+static enum ssd1306_err
+check_job(const struct ssd1306_downscale *job)
+{
+    if (job == NULL || job->src == NULL || job->dst == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (job->src_width == 0 || job->src_height == 0 || job->width == 0
+             || job->height == 0 || job->width > SSD1306_IMAGE_MAX_WIDTH) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    if (job->filter == SSD1306_SCALE_BOX) {
+        if (job->src_width > SSD1306_SCALE_MAX_SRC_WIDTH) {
+            return SSD1306_OUT_OF_DIMENSION;
+        }
+        else if ((job->src_height + job->height - 1) / job->height
+                 > MAX_BOX_ROWS) {
+            return SSD1306_SCALE_UNSUPPORTED;
+        }
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Finds the source pixels @c [*first, *end) output pixel @c i of @c len
+ * covers. Every output pixel covers at least one source pixel.
+ */
+static void
+source_span(uint32_t i, uint32_t len, uint32_t src_len, uint32_t *first,
+            uint32_t *end)
+{
+    *first = i * src_len / len;
+    *end = (i + 1) * src_len / len;
+
+    if (*end <= *first) {
+        *end = *first + 1;
+    }
+}
+
+/**
+ * Adds a row of source pixels to a row of 16 bit sums.
+ */
+static void
+accumulate(uint16_t *sums, const uint8_t *row, size_t len)
+{
+    size_t x = 0;
+
+#if defined(SCALE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; x + 16 <= len; x += 16) {
+        __m128i pixels = _mm_loadu_si128((const __m128i *)&row[x]);
+        __m128i lo = _mm_loadu_si128((const __m128i *)&sums[x]);
+        __m128i hi = _mm_loadu_si128((const __m128i *)&sums[x + 8]);
+
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(pixels, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(pixels, zero));
+
+        _mm_storeu_si128((__m128i *)&sums[x], lo);
+        _mm_storeu_si128((__m128i *)&sums[x + 8], hi);
+    }
+#elif defined(SCALE_NEON)
+    for (; x + 16 <= len; x += 16) {
+        uint8x16_t pixels = vld1q_u8(&row[x]);
+
+        vst1q_u16(&sums[x], vaddw_u8(vld1q_u16(&sums[x]), vget_low_u8(pixels)));
+        vst1q_u16(&sums[x + 8],
+                  vaddw_u8(vld1q_u16(&sums[x + 8]), vget_high_u8(pixels)));
+    }
+#endif
+
+    for (; x < len; x++) {
+        sums[x] = (uint16_t)(sums[x] + row[x]);
+    }
+}
+
+/**
+ * Averages the source pixels covered by each pixel of output row @c y.
+ */
+static void
+box_row(const struct ssd1306_downscale *job, uint16_t y, uint8_t *line)
+{
+    uint16_t sums[SSD1306_SCALE_MAX_SRC_WIDTH];
+    uint32_t first_row;
+    uint32_t end_row;
+
+    source_span(y, job->height, job->src_height, &first_row, &end_row);
+    memset(sums, 0, job->src_width * sizeof(sums[0]));
+
+    /* Sum the rows first so the horizontal pass runs once per output row. */
+    for (uint32_t row = first_row; row < end_row; row++) {
+        accumulate(sums, &job->src[row * job->src_stride], job->src_width);
+    }
+
+    for (uint32_t x = 0; x < job->width; x++) {
+        uint32_t first_col;
+        uint32_t end_col;
+        uint32_t sum = 0;
+
+        source_span(x, job->width, job->src_width, &first_col, &end_col);
+
+        for (uint32_t col = first_col; col < end_col; col++) {
+            sum += sums[col];
+        }
+
+        uint32_t count = (end_col - first_col) * (end_row - first_row);
+
+        line[x] = (uint8_t)((sum + count / 2) / count);
+    }
+}
+
+/**
+ * Finds the source pixel closest to the center of output pixel @c i of
+ * @c len.
+ */
+static uint32_t
+nearest(uint32_t i, uint32_t len, uint32_t src_len)
+{
+    return (2 * i + 1) * src_len / (2 * len);
+}
+
+enum ssd1306_err
+ssd1306_downscale_pages(const struct ssd1306_downscale *job,
+                        uint16_t first_page, uint16_t num_pages)
+{
+    SSD1306_RETURN_ON_ERR(check_job(job));
+
+    if (first_page >= output_pages(job)) {
+        return SSD1306_OK;
+    }
+
+    uint32_t first_row = (uint32_t)first_page * SSD1306_ROWS_PER_PAGE;
+    uint32_t end_row =
+        first_row + (uint32_t)num_pages * SSD1306_ROWS_PER_PAGE;
+    struct ssd1306_ditherer ditherer;
+    uint8_t line[SSD1306_IMAGE_MAX_WIDTH];
+    uint16_t cols[SSD1306_IMAGE_MAX_WIDTH];
+
+    if (end_row > job->height) {
+        end_row = job->height;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_ditherer_init(&ditherer, job->dither,
+                                                job->width,
+                                                (uint16_t)first_row, job->dst));
+
+    if (job->filter == SSD1306_SCALE_NEAREST) {
+        for (uint32_t x = 0; x < job->width; x++) {
+            cols[x] = (uint16_t)nearest(x, job->width, job->src_width);
+        }
+    }
+
+    for (uint32_t y = first_row; y < end_row; y++) {
+        if (job->filter == SSD1306_SCALE_BOX) {
+            box_row(job, (uint16_t)y, line);
+        }
+        else {
+            const uint8_t *row =
+                &job->src[nearest(y, job->height, job->src_height)
+                          * job->src_stride];
+
+            for (uint32_t x = 0; x < job->width; x++) {
+                line[x] = row[cols[x]];
+            }
+        }
+
+        ssd1306_ditherer_push_row(&ditherer, line);
+    }
+
+    ssd1306_ditherer_finish(&ditherer);
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_downscale(const struct ssd1306_downscale *job)
+{
+    SSD1306_RETURN_ON_ERR(check_job(job));
+
+    return ssd1306_downscale_pages(job, 0, output_pages(job));
+}
+
+#if defined(SSD1306_HAVE_PTHREADS)
+/**
+ * A band of pages scaled by one thread.
+ */
+struct band {
+    const struct ssd1306_downscale *job;
+    uint16_t first_page;
+    uint16_t num_pages;
+    enum ssd1306_err err;
+};
+
+static void *
+scale_band(void *arg)
+{
+    struct band *band = arg;
+
+    band->err =
+        ssd1306_downscale_pages(band->job, band->first_page, band->num_pages);
+
+    return NULL;
+}
+
+enum ssd1306_err
+ssd1306_downscale_parallel(const struct ssd1306_downscale *job,
+                           unsigned num_threads)
+{
+    SSD1306_RETURN_ON_ERR(check_job(job));
+
+    uint16_t pages = output_pages(job);
+
+    if (num_threads > MAX_THREADS) {
+        num_threads = MAX_THREADS;
+    }
+
+    if (num_threads > pages) {
+        num_threads = pages;
+    }
+
+    /* Error diffusion carries from one band to the next. */
+    if (num_threads <= 1 || job->dither == SSD1306_DITHER_FLOYD_STEINBERG) {
+        return ssd1306_downscale(job);
+    }
+
+    struct band bands[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    bool started[MAX_THREADS] = {false};
+    uint16_t first_page = 0;
+
+    for (unsigned i = 0; i < num_threads; i++) {
+        uint16_t count = (uint16_t)((pages - first_page) / (num_threads - i));
+
+        bands[i] = (struct band){job, first_page, count, SSD1306_OK};
+        first_page = (uint16_t)(first_page + count);
+    }
+
+    for (unsigned i = 1; i < num_threads; i++) {
+        started[i] =
+            pthread_create(&threads[i], NULL, scale_band, &bands[i]) == 0;
+
+        /* Scale the band here if a thread can't be had. */
+        if (!started[i]) {
+            scale_band(&bands[i]);
+        }
+    }
+
+    scale_band(&bands[0]);
+
+    for (unsigned i = 1; i < num_threads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    for (unsigned i = 0; i < num_threads; i++) {
+        SSD1306_RETURN_ON_ERR(bands[i].err);
+    }
+
+    return SSD1306_OK;
+}
+#endif
@@ -0,0 +1,28 @@
+#include "scroll.h"
+
+#include "ssd1306/ssd1306.h"
+
+#include <stdint.h>
+
+uint16_t
+ssd1306_scroll_step_frames(enum ssd1306_scroll_step interval)
+{
+    switch (interval) {
+        case SSD1306_2_FRAMES:
+            return 2;
+        case SSD1306_3_FRAMES:
+            return 3;
+        case SSD1306_4_FRAMES:
+            return 4;
+        case SSD1306_5_FRAMES:
+            return 5;
+        case SSD1306_25_FRAMES:
+            return 25;
+        case SSD1306_64_FRAMES:
+            return 64;
+        case SSD1306_128_FRAMES:
+            return 128;
+        default:
+            return 256;
+    }
+}
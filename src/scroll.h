@@ -0,0 +1,22 @@
+/**
+ * @file
+ *
+ * Timing of the hardware scroll, shared by the modules that follow it.
+ * Internal to the library.
+ */
+
+#ifndef LIBSSD1306_SRC_SCROLL_H
+#define LIBSSD1306_SRC_SCROLL_H
+
+#include "ssd1306/ssd1306.h"
+
+#include <stdint.h>
+
+/**
+ * Returns the number of frames between scroll steps.
+ *
+ * @param interval interval to convert
+ */
+uint16_t ssd1306_scroll_step_frames(enum ssd1306_scroll_step interval);
+
+#endif /* LIBSSD1306_SRC_SCROLL_H */
@@ -0,0 +1,179 @@
+#include "ssd1306/shadow.h"
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include "window.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h> /* memcmp, memcpy */
+
+static uint8_t
+num_pages(const struct ssd1306_shadow *shadow)
+{
+    return (uint8_t)(shadow->height / SSD1306_ROWS_PER_PAGE);
+}
+
+enum ssd1306_err
+ssd1306_shadow_init(struct ssd1306_shadow *shadow, uint8_t *buf,
+                    uint16_t width, uint16_t height)
+{
+    if (shadow == NULL || buf == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (width == 0 || width > SSD1306_FB_MAX_WIDTH || height == 0
+             || height > SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE
+             || height % SSD1306_ROWS_PER_PAGE != 0) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    shadow->buf = buf;
+    shadow->width = width;
+    shadow->height = height;
+    shadow->first_page = 0;
+
+    ssd1306_shadow_invalidate(shadow);
+
+    return SSD1306_OK;
+}
+
+void
+ssd1306_shadow_invalidate(struct ssd1306_shadow *shadow)
+{
+    shadow->stale = (uint8_t)((1U << num_pages(shadow)) - 1);
+}
+
+/**
+ * Finds the columns of @c page that differ between the shadow and
+ * @c frame. The page is clean when @c first is greater than @c last.
+ */
+static void
+diff_page(const struct ssd1306_shadow *shadow, const uint8_t *frame,
+          uint8_t page, uint8_t *first, uint8_t *last)
+{
+    size_t offset = (size_t)page * shadow->width;
+    const uint8_t *old = &shadow->buf[offset];
+    const uint8_t *cur = &frame[offset];
+    size_t lo = 0;
+    size_t hi = shadow->width - 1U;
+
+    if (!(shadow->stale & (1U << page))) {
+        if (memcmp(old, cur, shadow->width) == 0) {
+            *first = 1;
+            *last = 0;
+            return;
+        }
+
+        while (old[lo] == cur[lo]) {
+            lo++;
+        }
+
+        while (old[hi] == cur[hi]) {
+            hi--;
+        }
+    }
+
+    *first = (uint8_t)lo;
+    *last = (uint8_t)hi;
+}
+
+/**
+ * Sends a window of @c frame and copies it into the shadow.
+ */
+static enum ssd1306_err
+flush_window(struct ssd1306_ctx *ctx, struct ssd1306_shadow *shadow,
+             const uint8_t *frame, const struct ssd1306_window *window)
+{
+    size_t cols = (size_t)(window->last_col - window->first_col + 1);
+
+    SSD1306_RETURN_ON_ERR(ssd1306_window_write(
+        ctx, frame, shadow->width, shadow->first_page, window));
+
+    for (uint8_t page = window->first_page; page <= window->last_page;
+         page++) {
+        size_t offset = (size_t)page * shadow->width + window->first_col;
+
+        memcpy(&shadow->buf[offset], &frame[offset], cols);
+
+        /* Stale pages span the full width, so the window covers them whole. */
+        shadow->stale &= (uint8_t)~(1U << page);
+    }
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_shadow_flush(struct ssd1306_ctx *ctx, struct ssd1306_shadow *shadow,
+                     const uint8_t *frame, const struct ssd1306_bus_model *bus,
+                     uint32_t budget_ns, bool *done)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (shadow == NULL || frame == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* Frames are laid out for landscape. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+    /* Rows the panel doesn't show are still RAM, so only check against it. */
+    else if (shadow->width > ctx->width
+             || shadow->first_page + num_pages(shadow)
+                    > SSD1306_FB_MAX_PAGES) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    uint8_t first[SSD1306_FB_MAX_PAGES];
+    uint8_t last[SSD1306_FB_MAX_PAGES];
+    const struct ssd1306_spans spans = {
+        .first = first,
+        .last = last,
+        .num_pages = num_pages(shadow),
+        .width = shadow->width,
+        .col_bytes = 1,
+    };
+    uint64_t spent = 0;
+    uint8_t page = 0;
+
+    /* Without a model every byte costs 1 and there's no budget. */
+    if (bus == NULL) {
+        budget_ns = UINT32_MAX;
+    }
+
+    for (uint8_t p = 0; p < num_pages(shadow); p++) {
+        diff_page(shadow, frame, p, &first[p], &last[p]);
+    }
+
+    while (page < num_pages(shadow)) {
+        if (!ssd1306_spans_is_dirty(&spans, page)) {
+            page++;
+            continue;
+        }
+
+        struct ssd1306_window window;
+        uint32_t cost =
+            ssd1306_window_grow(&spans, bus, page, NULL, NULL, &window);
+
+        if (spent != 0 && spent + cost > budget_ns) {
+            break;
+        }
+
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+        SSD1306_RETURN_ON_ERR(flush_window(ctx, shadow, frame, &window));
+
+        spent += cost;
+        page = window.last_page + 1;
+    }
+
+    if (done != NULL) {
+        *done = page >= num_pages(shadow);
+    }
+
+    return ssd1306_resume_scrolling(ctx);
+}
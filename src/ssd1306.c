@@ -1,11 +1,15 @@
 #include "ssd1306/ssd1306.h"
 
 #include "ssd1306/err.h"
+#include "ssd1306/frame.h"
 #include "ssd1306/platform.h"
 
+#include "scroll.h"
+
 #include <stdbool.h>
 #include <stddef.h> /* NULL, size_t */
 #include <stdint.h>
+#include <string.h> /* memcpy */
 
 /**
  * @todo Correctly check the validity of the parameters passed in to all
@@ -102,12 +106,28 @@ ssd1306_init_display(struct ssd1306_ctx *ctx, bool should_clear_display)
     SSD1306_RETURN_ON_ERR(check_ctx(ctx, CHECK_SEND_CMD | CHECK_WRITE_DATA));
     SSD1306_RETURN_ON_ERR(check_dimensions(ctx, CHECK_WIDTH | CHECK_HEIGHT));
 
-    SSD1306_RETURN_ON_ERR(ssd1306_set_active_rows(ctx, SSD1306_ROW_63));
+    if (ctx->height > SSD1306_ROW_63 + 1) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    /* Panels with fewer rows, like 128x32 ones, only drive ctx->height. */
+    SSD1306_RETURN_ON_ERR(ssd1306_set_active_rows(
+        ctx, (enum ssd1306_row)(ctx->height - 1)));
     SSD1306_RETURN_ON_ERR(ssd1306_set_vert_offset(ctx, SSD1306_ROW_0));
     SSD1306_RETURN_ON_ERR(ssd1306_set_start_line(ctx, SSD1306_ROW_0));
 
-    SSD1306_RETURN_ON_ERR(ssd1306_disable_vert_reflection(ctx));
-    SSD1306_RETURN_ON_ERR(ssd1306_disable_horiz_reflection(ctx));
+    /*
+     * 128x64 panels interleave the rows between both sides of the COM pins,
+     * 128x32 ones (and smaller) wire them sequentially. The reset value only
+     * suits the former.
+     */
+    SSD1306_RETURN_ON_ERR(ssd1306_set_common_pin_config(
+        ctx,
+        ctx->height > SSD1306_ROW_31 + 1 ? SSD1306_ALT_COMMON_PINS
+                                         : SSD1306_SEQUENTIAL_COMMON_PINS,
+        SSD1306_DISABLE_LEFT_RIGHT_REMAP));
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_rotation(ctx, ctx->rotation));
 
     SSD1306_RETURN_ON_ERR(ssd1306_set_contrast(ctx, 127));
 
@@ -317,6 +337,49 @@ check_bounds(const struct ssd1306_ctx *ctx, enum ssd1306_page upper_bound,
 
 /** @{ */
 
+/**
+ * Index of the interval in every scroll setup command.
+ */
+#define SCROLL_SETUP_INTERVAL 3
+
+/**
+ * Counts the steps taken since the scroll last started or resumed. Partial
+ * steps are lost when it stops, since the next start begins a fresh interval.
+ */
+static uint32_t
+count_run_steps(const struct ssd1306_ctx *ctx)
+{
+    const struct ssd1306_frame_clock *clock = ctx->scroll.clock;
+
+    if (clock == NULL || clock->period_ns == 0
+        || ctx->scroll.state != SSD1306_SCROLL_RUNNING
+        || ctx->scroll.setup_len <= SCROLL_SETUP_INTERVAL) {
+        return 0;
+    }
+
+    uint64_t now = clock->now_ns(clock->user);
+    uint64_t frames = now > ctx->scroll.resumed_ns
+                          ? (now - ctx->scroll.resumed_ns) / clock->period_ns
+                          : 0;
+
+    return (uint32_t)(frames
+                      / ssd1306_scroll_step_frames(
+                          (enum ssd1306_scroll_step)
+                              ctx->scroll.setup[SCROLL_SETUP_INTERVAL]));
+}
+
+/**
+ * Records that the display just started scrolling.
+ */
+static void
+mark_scroll_running(struct ssd1306_ctx *ctx)
+{
+    const struct ssd1306_frame_clock *clock = ctx->scroll.clock;
+
+    ctx->scroll.state = SSD1306_SCROLL_RUNNING;
+    ctx->scroll.resumed_ns = clock != NULL ? clock->now_ns(clock->user) : 0;
+}
+
 enum ssd1306_err
 ssd1306_start_scrolling(struct ssd1306_ctx *ctx)
 {
@@ -324,6 +387,9 @@ ssd1306_start_scrolling(struct ssd1306_ctx *ctx)
 
     SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, SSD1306_START_SCROLLING));
 
+    ctx->scroll.steps = 0;
+    mark_scroll_running(ctx);
+
     return SSD1306_OK;
 }
 
@@ -334,6 +400,9 @@ ssd1306_stop_scrolling(struct ssd1306_ctx *ctx)
 
     SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, SSD1306_STOP_SCROLLING));
 
+    ctx->scroll.state = SSD1306_SCROLL_STOPPED;
+    ctx->scroll.clock = NULL;
+
     /*
      * TODO(rewrite data to RAM to not risk data corruption)
      * Ideally, the data will be buffered by the library so that
@@ -350,21 +419,18 @@ ssd1306_stop_scrolling(struct ssd1306_ctx *ctx)
 /**
  * Of all the scrolling commands, there are 4 that configure horizontal
  * scrolling. The functions that implement those commands have to call this
- * function to configure the horizontal scrolling.
+ * function to send the configuration. It's also remembered in
+ * @ref ssd1306_ctx::scroll, so it can be sent again after a pause.
  */
 static enum ssd1306_err
-setup_horiz_scroll_params(struct ssd1306_ctx *ctx,
-                          enum ssd1306_scrolling_command scroll_dir,
-                          enum ssd1306_page upper_bound,
-                          enum ssd1306_scroll_step interval,
-                          enum ssd1306_page lower_bound)
+send_scroll_setup(struct ssd1306_ctx *ctx, const uint8_t *cmd_list,
+                  size_t cmd_list_len)
 {
-    const uint8_t cmd_list[] = {
-        scroll_dir, SSD1306_DUMMY_BYTE_0S, upper_bound, interval, lower_bound,
-    };
+    SSD1306_RETURN_ON_ERR(ssd1306_send_cmd_list(ctx, cmd_list, cmd_list_len));
 
-    SSD1306_RETURN_ON_ERR(
-        ssd1306_send_cmd_list(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list)));
+    memcpy(ctx->scroll.setup, cmd_list, cmd_list_len);
+    ctx->scroll.setup_len = (uint8_t)cmd_list_len;
+    ctx->scroll.clock = NULL;
 
     return SSD1306_OK;
 }
@@ -381,13 +447,12 @@ setup_horiz_nonvert_scroll_params(struct ssd1306_ctx *ctx,
                                   enum ssd1306_scroll_step interval,
                                   enum ssd1306_page lower_bound)
 {
-    SSD1306_RETURN_ON_ERR(setup_horiz_scroll_params(
-        ctx, scroll_dir, upper_bound, interval, lower_bound));
-
-    SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, SSD1306_DUMMY_BYTE_0S));
-    SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, SSD1306_DUMMY_BYTE_1S));
+    const uint8_t cmd_list[] = {
+        scroll_dir,  SSD1306_DUMMY_BYTE_0S, upper_bound,           interval,
+        lower_bound, SSD1306_DUMMY_BYTE_0S, SSD1306_DUMMY_BYTE_1S,
+    };
 
-    return SSD1306_OK;
+    return send_scroll_setup(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list));
 }
 
 enum ssd1306_err
@@ -433,12 +498,12 @@ setup_horiz_vert_scroll_params(struct ssd1306_ctx *ctx,
                                enum ssd1306_page lower_bound,
                                enum ssd1306_row vertical_offset)
 {
-    SSD1306_RETURN_ON_ERR(setup_horiz_scroll_params(
-        ctx, scroll_dir, upper_bound, interval, lower_bound));
-
-    SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, vertical_offset));
+    const uint8_t cmd_list[] = {
+        scroll_dir, SSD1306_DUMMY_BYTE_0S, upper_bound,
+        interval,   lower_bound,           vertical_offset,
+    };
 
-    return SSD1306_OK;
+    return send_scroll_setup(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list));
 }
 
 enum ssd1306_err
@@ -495,6 +560,58 @@ ssd1306_set_vert_scroll_area(struct ssd1306_ctx *ctx,
     return SSD1306_OK;
 }
 
+enum ssd1306_err
+ssd1306_pause_scrolling(struct ssd1306_ctx *ctx)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ctx->scroll.state != SSD1306_SCROLL_RUNNING) {
+        return SSD1306_OK;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, SSD1306_STOP_SCROLLING));
+
+    ctx->scroll.steps += count_run_steps(ctx);
+    ctx->scroll.state = SSD1306_SCROLL_PAUSED;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_resume_scrolling(struct ssd1306_ctx *ctx)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (ctx->scroll.state != SSD1306_SCROLL_PAUSED) {
+        return SSD1306_OK;
+    }
+
+    /* The setup has to be sent again after a stop, so batch it with START. */
+    uint8_t cmd_list[SSD1306_SCROLL_SETUP_MAX_LEN + 1];
+    size_t len = ctx->scroll.setup_len;
+
+    memcpy(cmd_list, ctx->scroll.setup, len);
+    cmd_list[len++] = SSD1306_START_SCROLLING;
+
+    SSD1306_RETURN_ON_ERR(ssd1306_send_cmd_list(ctx, cmd_list, len));
+
+    mark_scroll_running(ctx);
+
+    return SSD1306_OK;
+}
+
+uint32_t
+ssd1306_scroll_steps(const struct ssd1306_ctx *ctx)
+{
+    if (ctx == NULL) {
+        return 0;
+    }
+
+    return ctx->scroll.steps + count_run_steps(ctx);
+}
+
 /** @} */ /* scrolling_commands */
 
 /**
@@ -605,6 +722,9 @@ ssd1306_set_active_rows(struct ssd1306_ctx *ctx, enum ssd1306_row rows)
     SSD1306_RETURN_ON_ERR(
         ssd1306_send_cmd_list(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list)));
 
+    ctx->timing.active_rows = cmd_list[1];
+    ctx->timing.programmed |= SSD1306_TIMING_ACTIVE_ROWS;
+
     return SSD1306_OK;
 }
 
@@ -617,6 +737,8 @@ ssd1306_set_start_line(struct ssd1306_ctx *ctx, enum ssd1306_row start_line)
 
     SSD1306_RETURN_ON_ERR(ssd1306_send_cmd(ctx, cmd));
 
+    ctx->start_line = start_line & 0x3F;
+
     return SSD1306_OK;
 }
 
@@ -698,6 +820,42 @@ ssd1306_set_common_pin_config(struct ssd1306_ctx *ctx,
     return SSD1306_OK;
 }
 
+enum ssd1306_err
+ssd1306_set_rotation(struct ssd1306_ctx *ctx, enum ssd1306_rotation rotation)
+{
+    SSD1306_RETURN_ON_ERR(check_ctx(ctx, CHECK_SEND_CMD));
+
+    /*
+     * Portrait framebuffers are flushed transposed, which is a reflection
+     * across the diagonal. One more reflection turns that into either
+     * quarter turn.
+     */
+    bool mirror_cols =
+        rotation == SSD1306_ROTATE_90 || rotation == SSD1306_ROTATE_180;
+    bool mirror_rows =
+        rotation == SSD1306_ROTATE_180 || rotation == SSD1306_ROTATE_270;
+    const uint8_t cmd_list[] = {
+        mirror_cols ? SSD1306_ENABLE_VERT_REFLECTION
+                    : SSD1306_DISABLE_VERT_REFLECTION,
+        mirror_rows ? SSD1306_ENABLE_HORIZ_REFLECTION
+                    : SSD1306_DISABLE_HORIZ_REFLECTION,
+    };
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_send_cmd_list(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list)));
+
+    ctx->rotation = rotation;
+
+    return SSD1306_OK;
+}
+
+bool
+ssd1306_is_portrait(const struct ssd1306_ctx *ctx)
+{
+    return ctx->rotation == SSD1306_ROTATE_90
+           || ctx->rotation == SSD1306_ROTATE_270;
+}
+
 /** @} */ /* hardware_configuration_commands */
 
 /**
@@ -720,6 +878,9 @@ ssd1306_config_timing(struct ssd1306_ctx *ctx,
     SSD1306_RETURN_ON_ERR(
         ssd1306_send_cmd_list(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list)));
 
+    ctx->timing.clock = cmd_list[1];
+    ctx->timing.programmed |= SSD1306_TIMING_CLOCK;
+
     return SSD1306_OK;
 }
 
@@ -738,6 +899,9 @@ ssd1306_set_precharge_period(struct ssd1306_ctx *ctx,
     SSD1306_RETURN_ON_ERR(
         ssd1306_send_cmd_list(ctx, cmd_list, SSD1306_ARRAY_LEN(cmd_list)));
 
+    ctx->timing.precharge = cmd_list[1];
+    ctx->timing.programmed |= SSD1306_TIMING_PRECHARGE;
+
     return SSD1306_OK;
 }
 
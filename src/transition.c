@@ -0,0 +1,565 @@
+#include "ssd1306/transition.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include "page.h"
+#include "scroll.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * Rows in the display's RAM.
+ */
+#define RAM_ROWS (SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE)
+
+/**
+ * Most bytes pausing and resuming a scroll take.
+ */
+#define PAUSE_LEN (1 + SSD1306_SCROLL_SETUP_MAX_LEN + 1)
+
+/**
+ * Finds the columns where @c cur differs from @c prev, or all of them if
+ * @c prev is @c NULL. Returns the bytes a window over them takes, 0 if there
+ * are none.
+ */
+static uint16_t
+diff_cols(const uint8_t *prev, const uint8_t *cur, uint16_t width,
+          uint16_t *first, uint16_t *last)
+{
+    *first = 0;
+    *last = (uint16_t)(width - 1);
+
+    if (prev != NULL) {
+        while (*first < width && prev[*first] == cur[*first]) {
+            (*first)++;
+        }
+
+        if (*first == width) {
+            return 0;
+        }
+
+        while (prev[*last] == cur[*last]) {
+            (*last)--;
+        }
+    }
+
+    return (uint16_t)(SSD1306_WINDOW_CMD_LEN + *last - *first + 1);
+}
+
+/**
+ * Writes columns @c first to @c last of @c page, taken from @c cols.
+ */
+static enum ssd1306_err
+write_cols(struct ssd1306_ctx *ctx, uint8_t page, const uint8_t *cols,
+           uint16_t first, uint16_t last)
+{
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, (uint8_t)first, (uint8_t)last));
+    SSD1306_RETURN_ON_ERR(ssd1306_set_page_range(ctx, page, page));
+
+    return ssd1306_write_data_list(ctx, &cols[first],
+                                   (size_t)(last - first + 1));
+}
+
+/**
+ * Writes columns @c first to @c first + @c cols - 1 of every page of the
+ * display. @c src points at the first column to write in a screen's first
+ * page.
+ */
+static enum ssd1306_err
+write_window(struct ssd1306_ctx *ctx, const uint8_t *src, uint16_t first,
+             uint16_t cols)
+{
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+    struct ssd1306_data_chunk chunk = {.len = 0};
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_col_range(
+        ctx, (uint8_t)first, (uint8_t)(first + cols - 1)));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, 0, (uint8_t)(pages - 1)));
+
+    for (uint8_t page = 0; page < pages; page++) {
+        SSD1306_RETURN_ON_ERR(ssd1306_chunk_push_list(
+            ctx, &chunk, &src[page * ctx->width], cols));
+    }
+
+    return ssd1306_chunk_flush(ctx, &chunk);
+}
+
+/**
+ * Returns the start line once a slide has moved @c rows rows.
+ */
+static uint8_t
+slide_line(const struct ssd1306_transition *transition, uint16_t rows)
+{
+    if (transition->effect == SSD1306_TRANSITION_SLIDE_UP) {
+        return (uint8_t)(rows % RAM_ROWS);
+    }
+
+    return (uint8_t)((RAM_ROWS - rows) % RAM_ROWS);
+}
+
+/**
+ * Returns the page of RAM that page @c page of the incoming screen is written
+ * to during a slide. It's where the page is shown once the slide is over.
+ */
+static uint8_t
+slide_ram_page(const struct ssd1306_ctx *ctx,
+               const struct ssd1306_transition *transition, uint8_t page)
+{
+    uint8_t end = slide_line(transition, ctx->height);
+
+    return (uint8_t)((page + end / SSD1306_ROWS_PER_PAGE)
+                     % SSD1306_FB_MAX_PAGES);
+}
+
+/**
+ * Returns the rows of page @c page of the incoming screen that are in view
+ * once a slide has moved @c rows rows.
+ */
+static uint8_t
+slide_shown(const struct ssd1306_ctx *ctx,
+            const struct ssd1306_transition *transition, uint8_t page,
+            int rows)
+{
+    if (transition->effect == SSD1306_TRANSITION_SLIDE_UP) {
+        return ssd1306_page_bits(page, 0, rows - 1);
+    }
+
+    return ssd1306_page_bits(page, ctx->height - rows, ctx->height - 1);
+}
+
+/**
+ * Returns the rows of @c ram_page that may hold the incoming screen once a
+ * slide has moved @c rows rows: all of them but the outgoing screen's rows
+ * still in view.
+ */
+static uint8_t
+slide_free(const struct ssd1306_ctx *ctx,
+           const struct ssd1306_transition *transition, uint8_t ram_page,
+           int rows)
+{
+    int height = ctx->height;
+
+    if (ram_page >= height / SSD1306_ROWS_PER_PAGE) {
+        return 0xFF;
+    }
+    else if (transition->effect == SSD1306_TRANSITION_SLIDE_UP) {
+        return (uint8_t)~ssd1306_page_bits(ram_page, rows, height - 1);
+    }
+
+    return (uint8_t)~ssd1306_page_bits(ram_page, 0, height - 1 - rows);
+}
+
+/**
+ * Builds in @c cur what the RAM page that page @c page of the incoming screen
+ * goes to should hold, with the incoming screen in rows @c fresh. Points
+ * @c prev at what it holds now, or @c NULL if that isn't known.
+ */
+static void
+slide_bytes(const struct ssd1306_ctx *ctx,
+            const struct ssd1306_transition *transition, uint8_t page,
+            uint8_t fresh, uint8_t *cur, uint8_t *prev_buf,
+            const uint8_t **prev)
+{
+    uint8_t ram_page = slide_ram_page(ctx, transition, page);
+    uint8_t old = transition->fresh[ram_page];
+    const uint8_t *in = &transition->to[page * ctx->width];
+
+    /* RAM past the outgoing screen holds whatever it held before. */
+    if (ram_page >= ctx->height / SSD1306_ROWS_PER_PAGE) {
+        for (uint16_t col = 0; col < ctx->width; col++) {
+            cur[col] = in[col];
+        }
+
+        *prev = old == 0xFF ? cur : NULL;
+        return;
+    }
+
+    const uint8_t *out = &transition->from[ram_page * ctx->width];
+
+    for (uint16_t col = 0; col < ctx->width; col++) {
+        cur[col] = (uint8_t)((in[col] & fresh) | (out[col] & ~fresh));
+        prev_buf[col] = (uint8_t)((in[col] & old) | (out[col] & ~old));
+    }
+
+    *prev = prev_buf;
+}
+
+/**
+ * Returns the bytes it takes to show @c rows rows of a slide, counting only
+ * the pages that have to be written.
+ */
+static uint32_t
+slide_cost(const struct ssd1306_ctx *ctx,
+           const struct ssd1306_transition *transition, int rows)
+{
+    uint8_t cur[SSD1306_FB_MAX_WIDTH];
+    uint8_t prev_buf[SSD1306_FB_MAX_WIDTH];
+    uint32_t cost = 0;
+
+    for (uint8_t page = 0; page < ctx->height / SSD1306_ROWS_PER_PAGE;
+         page++) {
+        uint8_t ram_page = slide_ram_page(ctx, transition, page);
+        const uint8_t *prev;
+        uint16_t first, last;
+
+        if ((slide_shown(ctx, transition, page, rows)
+             & ~transition->fresh[ram_page])
+            == 0) {
+            continue;
+        }
+
+        slide_bytes(ctx, transition, page,
+                    slide_free(ctx, transition, ram_page, rows), cur,
+                    prev_buf, &prev);
+        cost += diff_cols(prev, cur, ctx->width, &first, &last);
+    }
+
+    return cost;
+}
+
+/**
+ * Copies the incoming screen back to the start of RAM, out of view, once a
+ * slide on a display of 32 rows or less is over, then moves the start line
+ * back to 0.
+ */
+static enum ssd1306_err
+slide_settle(struct ssd1306_ctx *ctx, struct ssd1306_transition *transition,
+             bool *done)
+{
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+    uint8_t page = (uint8_t)(transition->pos - ctx->height);
+    uint32_t spent = 0;
+
+    if (ctx->height == RAM_ROWS) {
+        *done = true;
+        return SSD1306_OK;
+    }
+
+    /* That RAM still holds the outgoing screen. */
+    for (; page < pages; page++) {
+        const uint8_t *in = &transition->to[page * ctx->width];
+        uint16_t first, last;
+        uint16_t cost = diff_cols(&transition->from[page * ctx->width], in,
+                                  ctx->width, &first, &last);
+
+        if (cost == 0) {
+            continue;
+        }
+        else if (spent > 0 && spent + cost + 1 > transition->budget) {
+            break;
+        }
+
+        SSD1306_RETURN_ON_ERR(write_cols(ctx, page, in, first, last));
+
+        spent += cost;
+    }
+
+    transition->pos = (uint8_t)(ctx->height + page);
+    *done = page == pages;
+
+    if (!*done) {
+        return SSD1306_OK;
+    }
+
+    return ssd1306_set_start_line(ctx, SSD1306_ROW_0);
+}
+
+static enum ssd1306_err
+slide_tick(struct ssd1306_ctx *ctx, struct ssd1306_transition *transition,
+           bool *done)
+{
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+    int rows = transition->pos + transition->step;
+
+    if (transition->pos >= ctx->height) {
+        return slide_settle(ctx, transition, done);
+    }
+    else if (rows > ctx->height) {
+        rows = ctx->height;
+    }
+
+    /* The start line takes a byte too. */
+    while (rows > transition->pos + 1
+           && slide_cost(ctx, transition, rows) + 1 > transition->budget) {
+        rows--;
+    }
+
+    uint8_t cur[SSD1306_FB_MAX_WIDTH];
+    uint8_t prev_buf[SSD1306_FB_MAX_WIDTH];
+    uint32_t spent = 1;
+
+    /*
+     * Pages go out in the order they come into view. Those needed now are
+     * always written; the rest only while the budget lasts.
+     */
+    for (uint8_t i = 0; i < pages; i++) {
+        uint8_t page = transition->effect == SSD1306_TRANSITION_SLIDE_UP
+                           ? i
+                           : (uint8_t)(pages - 1 - i);
+        uint8_t ram_page = slide_ram_page(ctx, transition, page);
+        uint8_t fresh = slide_free(ctx, transition, ram_page, rows);
+        bool needed = (slide_shown(ctx, transition, page, rows)
+                       & ~transition->fresh[ram_page])
+                      != 0;
+        const uint8_t *prev;
+        uint16_t first, last;
+
+        if ((fresh & ~transition->fresh[ram_page]) == 0) {
+            continue;
+        }
+
+        slide_bytes(ctx, transition, page, fresh, cur, prev_buf, &prev);
+
+        uint16_t cost = diff_cols(prev, cur, ctx->width, &first, &last);
+
+        if (!needed && spent + cost > transition->budget) {
+            break;
+        }
+        else if (cost > 0) {
+            SSD1306_RETURN_ON_ERR(write_cols(ctx, ram_page, cur, first, last));
+        }
+
+        transition->fresh[ram_page] |= fresh;
+        spent += cost;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_set_start_line(
+        ctx, (enum ssd1306_row)slide_line(transition, (uint16_t)rows)));
+
+    transition->pos = (uint8_t)rows;
+
+    /* Full height displays end where they started. */
+    *done = transition->pos == RAM_ROWS;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+wipe_tick(struct ssd1306_ctx *ctx, struct ssd1306_transition *transition,
+          bool *done)
+{
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+    uint16_t cols = (uint16_t)(ctx->width - transition->pos);
+    uint16_t max_cols =
+        transition->budget > SSD1306_WINDOW_CMD_LEN
+            ? (uint16_t)((transition->budget - SSD1306_WINDOW_CMD_LEN) / pages)
+            : 0;
+
+    *done = cols == 0;
+
+    if (*done) {
+        return SSD1306_OK;
+    }
+
+    if (cols > transition->step) {
+        cols = transition->step;
+    }
+    if (cols > max_cols) {
+        cols = max_cols > 0 ? max_cols : 1;
+    }
+
+    uint16_t first = transition->effect == SSD1306_TRANSITION_WIPE_RIGHT
+                         ? transition->pos
+                         : (uint16_t)(ctx->width - transition->pos - cols);
+
+    SSD1306_RETURN_ON_ERR(
+        write_window(ctx, &transition->to[first], first, cols));
+
+    transition->pos = (uint8_t)(transition->pos + cols);
+    *done = transition->pos == ctx->width;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+push_tick(struct ssd1306_ctx *ctx, struct ssd1306_transition *transition,
+          bool *done)
+{
+    const struct ssd1306_frame_clock *clock = transition->clock;
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+    uint16_t left = (uint16_t)(ctx->width - transition->pos);
+
+    *done = left == 0;
+
+    if (*done) {
+        return SSD1306_OK;
+    }
+    else if (transition->pending == 0) {
+        uint64_t now = clock->now_ns(clock->user);
+        uint64_t frames = now > transition->start_ns
+                              ? (now - transition->start_ns) / clock->period_ns
+                              : 0;
+        uint64_t steps =
+            frames / ssd1306_scroll_step_frames(transition->interval);
+
+        if (steps == 0) {
+            return SSD1306_OK;
+        }
+
+        /*
+         * The scroll went past the end and wrapped the incoming screen
+         * itself around, so put it back whole.
+         */
+        if (steps > left) {
+            SSD1306_RETURN_ON_ERR(ssd1306_stop_scrolling(ctx));
+            SSD1306_RETURN_ON_ERR(
+                write_window(ctx, transition->to, 0, ctx->width));
+
+            transition->pos = (uint8_t)ctx->width;
+            *done = true;
+
+            return SSD1306_OK;
+        }
+
+        transition->pending = (uint8_t)steps;
+
+        SSD1306_RETURN_ON_ERR(ssd1306_pause_scrolling(ctx));
+    }
+
+    /* The scroll stays paused until every wrapped column is overwritten. */
+    uint16_t cols = transition->pending;
+    uint16_t max_cols =
+        transition->budget > SSD1306_WINDOW_CMD_LEN + PAUSE_LEN
+            ? (uint16_t)((transition->budget - SSD1306_WINDOW_CMD_LEN
+                          - PAUSE_LEN)
+                         / pages)
+            : 0;
+
+    if (cols > max_cols) {
+        cols = max_cols > 0 ? max_cols : 1;
+    }
+
+    /* The columns that wrapped first have moved furthest from the edge. */
+    if (transition->effect == SSD1306_TRANSITION_PUSH_LEFT) {
+        SSD1306_RETURN_ON_ERR(write_window(
+            ctx, &transition->to[transition->pos],
+            (uint16_t)(ctx->width - transition->pending), cols));
+    }
+    else {
+        SSD1306_RETURN_ON_ERR(write_window(
+            ctx, &transition->to[left - cols],
+            (uint16_t)(transition->pending - cols), cols));
+    }
+
+    transition->pos = (uint8_t)(transition->pos + cols);
+    transition->pending = (uint8_t)(transition->pending - cols);
+
+    if (transition->pending > 0) {
+        return SSD1306_OK;
+    }
+    else if (transition->pos == ctx->width) {
+        *done = true;
+
+        return ssd1306_stop_scrolling(ctx);
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_resume_scrolling(ctx));
+
+    transition->start_ns = clock->now_ns(clock->user);
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_transition_start(struct ssd1306_ctx *ctx,
+                         struct ssd1306_transition *transition,
+                         enum ssd1306_transition_effect effect,
+                         const uint8_t *from, const uint8_t *to, uint8_t step,
+                         uint16_t budget,
+                         const struct ssd1306_frame_clock *clock,
+                         enum ssd1306_scroll_step interval)
+{
+    bool slide = effect == SSD1306_TRANSITION_SLIDE_UP
+                 || effect == SSD1306_TRANSITION_SLIDE_DOWN;
+    bool push = effect == SSD1306_TRANSITION_PUSH_LEFT
+                || effect == SSD1306_TRANSITION_PUSH_RIGHT;
+
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (transition == NULL || from == NULL || to == NULL
+             || (push && clock == NULL)) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* Screens are page-major frames and move along the RAM as wired. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+    else if (step == 0 || ctx->width > SSD1306_FB_MAX_WIDTH
+             || (slide && ctx->height != RAM_ROWS
+                 && ctx->height > RAM_ROWS / 2)) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    transition->from = from;
+    transition->to = to;
+    transition->effect = (uint8_t)effect;
+    transition->step = step;
+    transition->budget = budget;
+    transition->pos = 0;
+    transition->pending = 0;
+    transition->clock = clock;
+    transition->interval = interval;
+
+    for (uint8_t page = 0; page < SSD1306_FB_MAX_PAGES; page++) {
+        transition->fresh[page] = 0;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_stop_scrolling(ctx));
+
+    if (!push) {
+        return SSD1306_OK;
+    }
+
+    enum ssd1306_page last_page =
+        (enum ssd1306_page)(ctx->height / SSD1306_ROWS_PER_PAGE - 1);
+
+    if (effect == SSD1306_TRANSITION_PUSH_LEFT) {
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_scroll_left(ctx, SSD1306_PAGE_0, interval, last_page));
+    }
+    else {
+        SSD1306_RETURN_ON_ERR(
+            ssd1306_scroll_right(ctx, SSD1306_PAGE_0, interval, last_page));
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_start_scrolling(ctx));
+
+    transition->start_ns = clock->now_ns(clock->user);
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_transition_tick(struct ssd1306_ctx *ctx,
+                        struct ssd1306_transition *transition, bool *done)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (transition == NULL || done == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    switch (transition->effect) {
+        case SSD1306_TRANSITION_SLIDE_UP:
+        case SSD1306_TRANSITION_SLIDE_DOWN:
+            return slide_tick(ctx, transition, done);
+        case SSD1306_TRANSITION_WIPE_LEFT:
+        case SSD1306_TRANSITION_WIPE_RIGHT:
+            return wipe_tick(ctx, transition, done);
+        default:
+            return push_tick(ctx, transition, done);
+    }
+}
@@ -0,0 +1,191 @@
+#include "ssd1306/transpose.h"
+
+#include <stddef.h> /* size_t */
+#include <stdint.h>
+#include <string.h> /* memcpy */
+
+#if !defined(SSD1306_NO_SIMD) && defined(__SSE2__)
+#define TRANSPOSE_SSE2
+#include <emmintrin.h>
+#elif !defined(SSD1306_NO_SIMD) && defined(__ARM_NEON)                        \
+    && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define TRANSPOSE_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+ * Bit c of row r is bit 8 * r + c of a 64 bit word. Each delta swap exchanges
+ * the bits selected by its mask with the bits 'shift' positions above them,
+ * which transposes the 2x2, then the 4x4 and finally the 8x8 blocks.
+ */
+#define SWAP_1_MASK  UINT64_C(0x00AA00AA00AA00AA)
+#define SWAP_1_SHIFT 7
+#define SWAP_2_MASK  UINT64_C(0x0000CCCC0000CCCC)
+#define SWAP_2_SHIFT 14
+#define SWAP_4_MASK  UINT64_C(0x00000000F0F0F0F0)
+#define SWAP_4_SHIFT 28
+
+/**
+ * Number of 8x8 blocks @ref ssd1306_rows_to_pages transposes per batch. 16
+ * blocks covers the display's 128 columns.
+ */
+#define BAND_BLOCKS 16
+
+/*
+ * Spelled out byte by byte so compilers merge them into a single load or
+ * store on little endian targets.
+ */
+static uint64_t
+load_u64(const uint8_t *bytes)
+{
+    return (uint64_t)bytes[0] | (uint64_t)bytes[1] << 8
+           | (uint64_t)bytes[2] << 16 | (uint64_t)bytes[3] << 24
+           | (uint64_t)bytes[4] << 32 | (uint64_t)bytes[5] << 40
+           | (uint64_t)bytes[6] << 48 | (uint64_t)bytes[7] << 56;
+}
+
+static void
+store_u64(uint8_t *bytes, uint64_t word)
+{
+    bytes[0] = (uint8_t)word;
+    bytes[1] = (uint8_t)(word >> 8);
+    bytes[2] = (uint8_t)(word >> 16);
+    bytes[3] = (uint8_t)(word >> 24);
+    bytes[4] = (uint8_t)(word >> 32);
+    bytes[5] = (uint8_t)(word >> 40);
+    bytes[6] = (uint8_t)(word >> 48);
+    bytes[7] = (uint8_t)(word >> 56);
+}
+
+static uint64_t
+delta_swap(uint64_t word, uint64_t mask, unsigned shift)
+{
+    uint64_t t = (word ^ (word >> shift)) & mask;
+
+    return word ^ t ^ (t << shift);
+}
+
+void
+ssd1306_transpose_8x8(const uint8_t *in, uint8_t *out)
+{
+    uint64_t word = load_u64(in);
+
+    word = delta_swap(word, SWAP_1_MASK, SWAP_1_SHIFT);
+    word = delta_swap(word, SWAP_2_MASK, SWAP_2_SHIFT);
+    word = delta_swap(word, SWAP_4_MASK, SWAP_4_SHIFT);
+
+    store_u64(out, word);
+}
+
+void
+ssd1306_transpose_8x8_batch(const uint8_t *in, uint8_t *out,
+                            size_t num_blocks)
+{
+    size_t block = 0;
+
+#if defined(TRANSPOSE_SSE2)
+    const __m128i mask_1 = _mm_set1_epi64x((long long)SWAP_1_MASK);
+    const __m128i mask_2 = _mm_set1_epi64x((long long)SWAP_2_MASK);
+    const __m128i mask_4 = _mm_set1_epi64x((long long)SWAP_4_MASK);
+
+    /* Each 64 bit lane holds a block. */
+    for (; block + 2 <= num_blocks; block += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i *)&in[block * 8]);
+        __m128i t;
+
+        t = _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi64(x, SWAP_1_SHIFT)),
+                          mask_1);
+        x = _mm_xor_si128(x, _mm_xor_si128(t, _mm_slli_epi64(t, SWAP_1_SHIFT)));
+        t = _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi64(x, SWAP_2_SHIFT)),
+                          mask_2);
+        x = _mm_xor_si128(x, _mm_xor_si128(t, _mm_slli_epi64(t, SWAP_2_SHIFT)));
+        t = _mm_and_si128(_mm_xor_si128(x, _mm_srli_epi64(x, SWAP_4_SHIFT)),
+                          mask_4);
+        x = _mm_xor_si128(x, _mm_xor_si128(t, _mm_slli_epi64(t, SWAP_4_SHIFT)));
+
+        _mm_storeu_si128((__m128i *)&out[block * 8], x);
+    }
+#elif defined(TRANSPOSE_NEON)
+    const uint64x2_t mask_1 = vdupq_n_u64(SWAP_1_MASK);
+    const uint64x2_t mask_2 = vdupq_n_u64(SWAP_2_MASK);
+    const uint64x2_t mask_4 = vdupq_n_u64(SWAP_4_MASK);
+
+    /* Each 64 bit lane holds a block. */
+    for (; block + 2 <= num_blocks; block += 2) {
+        uint64x2_t x = vreinterpretq_u64_u8(vld1q_u8(&in[block * 8]));
+        uint64x2_t t;
+
+        t = vandq_u64(veorq_u64(x, vshrq_n_u64(x, SWAP_1_SHIFT)), mask_1);
+        x = veorq_u64(x, veorq_u64(t, vshlq_n_u64(t, SWAP_1_SHIFT)));
+        t = vandq_u64(veorq_u64(x, vshrq_n_u64(x, SWAP_2_SHIFT)), mask_2);
+        x = veorq_u64(x, veorq_u64(t, vshlq_n_u64(t, SWAP_2_SHIFT)));
+        t = vandq_u64(veorq_u64(x, vshrq_n_u64(x, SWAP_4_SHIFT)), mask_4);
+        x = veorq_u64(x, veorq_u64(t, vshlq_n_u64(t, SWAP_4_SHIFT)));
+
+        vst1q_u8(&out[block * 8], vreinterpretq_u8_u64(x));
+    }
+#endif
+
+    for (; block < num_blocks; block++) {
+        ssd1306_transpose_8x8(&in[block * 8], &out[block * 8]);
+    }
+}
+
+/**
+ * Mirrors a byte so its most significant bit becomes its least significant.
+ */
+static uint8_t
+reverse_bits(uint8_t byte)
+{
+    byte = (uint8_t)((byte & 0xF0) >> 4 | (byte & 0x0F) << 4);
+    byte = (uint8_t)((byte & 0xCC) >> 2 | (byte & 0x33) << 2);
+    byte = (uint8_t)((byte & 0xAA) >> 1 | (byte & 0x55) << 1);
+
+    return byte;
+}
+
+void
+ssd1306_rows_to_pages(const uint8_t *src, size_t src_stride, uint16_t width,
+                      uint16_t height, enum ssd1306_bit_order order,
+                      uint8_t *dst)
+{
+    size_t num_blocks = ((size_t)width + 7) / 8;
+    uint8_t band[BAND_BLOCKS * 8];
+
+    for (size_t row = 0; row < height; row += 8) {
+        size_t rows = height - row < 8 ? height - row : 8;
+        uint8_t *page = &dst[(row / 8) * width];
+
+        for (size_t first = 0; first < num_blocks; first += BAND_BLOCKS) {
+            size_t blocks = num_blocks - first < BAND_BLOCKS
+                                ? num_blocks - first
+                                : BAND_BLOCKS;
+            size_t x = first * 8;
+            size_t cols = width - x < blocks * 8 ? width - x : blocks * 8;
+
+            /* Gather the rows of each block so they're back to back. */
+            for (size_t r = 0; r < 8; r++) {
+                if (r >= rows) {
+                    for (size_t block = 0; block < blocks; block++) {
+                        band[block * 8 + r] = 0x00;
+                    }
+
+                    continue;
+                }
+
+                const uint8_t *line = &src[(row + r) * src_stride + first];
+
+                for (size_t block = 0; block < blocks; block++) {
+                    band[block * 8 + r] = order == SSD1306_MSB_FIRST
+                                              ? reverse_bits(line[block])
+                                              : line[block];
+                }
+            }
+
+            ssd1306_transpose_8x8_batch(band, band, blocks);
+
+            /* A transposed block is 8 consecutive columns of the page. */
+            memcpy(&page[x], band, cols);
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include "ssd1306/viewport.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/shadow.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Rows in the display's RAM.
+ */
+#define RAM_ROWS (SSD1306_FB_MAX_PAGES * SSD1306_ROWS_PER_PAGE)
+
+static int32_t
+floor_div(int32_t a, int32_t b)
+{
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * Returns a byte of the image, or 0 outside of it.
+ */
+static uint8_t
+image_byte(const struct ssd1306_viewport *viewport, int32_t page,
+           uint32_t col)
+{
+    if (page < 0 || page >= viewport->image_height / SSD1306_ROWS_PER_PAGE
+        || col >= viewport->image_width) {
+        return 0;
+    }
+
+    return viewport->image[(size_t)page * viewport->image_width + col];
+}
+
+/**
+ * Fills a page of the frame with 8 rows of the image, starting @c phase rows
+ * into image page @c page.
+ */
+static void
+build_page(const struct ssd1306_viewport *viewport, uint8_t *dst, int32_t page,
+           uint16_t width)
+{
+    uint8_t phase = viewport->phase;
+
+    if (phase != 0) {
+        for (uint16_t i = 0; i < width; i++) {
+            uint32_t col = (uint32_t)viewport->x + i;
+
+            dst[i] = (uint8_t)((image_byte(viewport, page, col) >> phase)
+                               | (image_byte(viewport, page + 1, col)
+                                  << (SSD1306_ROWS_PER_PAGE - phase)));
+        }
+        return;
+    }
+
+    /* Aligned pages are a straight copy of the image. */
+    size_t copied = 0;
+
+    if (page >= 0 && page < viewport->image_height / SSD1306_ROWS_PER_PAGE
+        && viewport->x < viewport->image_width) {
+        copied = viewport->image_width - viewport->x;
+        copied = copied < width ? copied : width;
+
+        memcpy(dst,
+               &viewport->image[(size_t)page * viewport->image_width
+                                + viewport->x],
+               copied);
+    }
+
+    memset(&dst[copied], 0, width - copied);
+}
+
+enum ssd1306_err
+ssd1306_viewport_init(struct ssd1306_ctx *ctx,
+                      struct ssd1306_viewport *viewport, uint8_t *buf,
+                      const uint8_t *image, uint16_t image_width,
+                      uint16_t image_height)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (viewport == NULL || buf == NULL || image == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (image_height % SSD1306_ROWS_PER_PAGE != 0
+             || ctx->width > SSD1306_FB_MAX_WIDTH) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_shadow_init(&viewport->shadow, buf, ctx->width, RAM_ROWS));
+
+    /* Pages that are never shown are still diffed, so give them a value. */
+    memset(buf, 0, SSD1306_VIEWPORT_LEN(ctx->width));
+
+    viewport->image = image;
+    viewport->image_width = image_width;
+    viewport->image_height = image_height;
+    viewport->x = 0;
+    viewport->y = 0;
+    viewport->phase = 0;
+    viewport->frame = &buf[SSD1306_FB_LEN(ctx->width, RAM_ROWS)];
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_viewport_show(struct ssd1306_ctx *ctx,
+                      struct ssd1306_viewport *viewport, uint16_t x,
+                      uint16_t y)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (viewport == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    uint16_t width = viewport->shadow.width;
+    int32_t offset = (int32_t)y - viewport->phase;
+    int32_t rel = offset & (SSD1306_ROWS_PER_PAGE - 1);
+
+    /*
+     * Keep the image's rows where they are in RAM unless the display would
+     * need more pages than there are, which only happens on 64 row panels.
+     */
+    if ((rel + ctx->height + SSD1306_ROWS_PER_PAGE - 1) / SSD1306_ROWS_PER_PAGE
+        > SSD1306_FB_MAX_PAGES) {
+        viewport->phase = (uint8_t)(y % SSD1306_ROWS_PER_PAGE);
+        offset = (int32_t)y - viewport->phase;
+    }
+
+    viewport->x = x;
+    viewport->y = y;
+
+    int32_t first = floor_div(offset, SSD1306_ROWS_PER_PAGE);
+    int32_t last =
+        floor_div(offset + ctx->height - 1, SSD1306_ROWS_PER_PAGE);
+
+    /* Pages the display doesn't show are left as they are. */
+    memcpy(viewport->frame, viewport->shadow.buf,
+           SSD1306_FB_LEN(width, RAM_ROWS));
+
+    for (int32_t page = first; page <= last; page++) {
+        uint8_t ram_page = (uint8_t)(page & (SSD1306_FB_MAX_PAGES - 1));
+
+        build_page(viewport, &viewport->frame[ram_page * width], page, width);
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_shadow_flush(ctx, &viewport->shadow,
+                                               viewport->frame, NULL, 0, NULL));
+
+    return ssd1306_set_start_line(
+        ctx, (enum ssd1306_row)(offset & (RAM_ROWS - 1)));
+}
@@ -0,0 +1,130 @@
+#include "ssd1306/vscroll.h"
+
+#include "ssd1306/err.h"
+#include "ssd1306/frame.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include "scroll.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL */
+#include <stdint.h>
+
+enum ssd1306_err
+ssd1306_vscroll_init(struct ssd1306_ctx *ctx, struct ssd1306_vscroll *vscroll,
+                     const struct ssd1306_frame_clock *clock,
+                     uint8_t header_pages, enum ssd1306_scroll_step interval,
+                     uint8_t step_rows, enum ssd1306_page horiz_page,
+                     bool left)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (vscroll == NULL || clock == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* The scroll area is a band of the RAM's rows. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    uint8_t pages = (uint8_t)(ctx->height / SSD1306_ROWS_PER_PAGE);
+
+    if (header_pages >= pages
+        || step_rows >= (pages - header_pages) * SSD1306_ROWS_PER_PAGE) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    vscroll->clock = clock;
+    vscroll->header_pages = header_pages;
+    vscroll->body_pages = (uint8_t)(pages - header_pages);
+    vscroll->horiz_page = horiz_page;
+    vscroll->interval = interval;
+    vscroll->step_rows = step_rows;
+    vscroll->left = left;
+    vscroll->running = false;
+    vscroll->base_line = 0;
+    vscroll->start_ns = 0;
+
+    return ssd1306_set_vert_scroll_area(
+        ctx, (enum ssd1306_row)(header_pages * SSD1306_ROWS_PER_PAGE),
+        (enum ssd1306_row)(vscroll->body_pages * SSD1306_ROWS_PER_PAGE));
+}
+
+enum ssd1306_page
+ssd1306_vscroll_page(const struct ssd1306_vscroll *vscroll,
+                     uint16_t base_line, uint16_t line)
+{
+    uint16_t offset = (uint16_t)(line - base_line);
+
+    return (enum ssd1306_page)(vscroll->header_pages
+                               + offset % vscroll->body_pages);
+}
+
+enum ssd1306_err
+ssd1306_vscroll_start(struct ssd1306_ctx *ctx, struct ssd1306_vscroll *vscroll,
+                      uint16_t base_line)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (vscroll == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    enum ssd1306_row offset = (enum ssd1306_row)vscroll->step_rows;
+
+    if (vscroll->left) {
+        SSD1306_RETURN_ON_ERR(ssd1306_scroll_vert_left(
+            ctx, vscroll->horiz_page, vscroll->interval, vscroll->horiz_page,
+            offset));
+    }
+    else {
+        SSD1306_RETURN_ON_ERR(ssd1306_scroll_vert_right(
+            ctx, vscroll->horiz_page, vscroll->interval, vscroll->horiz_page,
+            offset));
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_start_scrolling(ctx));
+
+    vscroll->base_line = base_line;
+    vscroll->start_ns = vscroll->clock->now_ns(vscroll->clock->user);
+    vscroll->running = true;
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_vscroll_stop(struct ssd1306_ctx *ctx, struct ssd1306_vscroll *vscroll)
+{
+    if (vscroll == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_stop_scrolling(ctx));
+
+    vscroll->running = false;
+
+    return SSD1306_OK;
+}
+
+uint32_t
+ssd1306_vscroll_first_row(const struct ssd1306_vscroll *vscroll,
+                          uint64_t now_ns)
+{
+    uint32_t base_row = (uint32_t)vscroll->base_line * SSD1306_ROWS_PER_PAGE;
+
+    if (!vscroll->running || now_ns <= vscroll->start_ns
+        || vscroll->clock->period_ns == 0) {
+        return base_row;
+    }
+
+    uint64_t frames = (now_ns - vscroll->start_ns) / vscroll->clock->period_ns;
+    uint64_t steps = frames / ssd1306_scroll_step_frames(vscroll->interval);
+
+    return (uint32_t)(base_row + steps * vscroll->step_rows);
+}
@@ -0,0 +1,437 @@
+#include "ssd1306/vt.h"
+
+#include "ssd1306/console.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/font.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+#include <string.h>
+
+#define ESC 0x1B
+
+/**
+ * Columns between tab stops.
+ */
+#define TAB_WIDTH 8
+
+/**
+ * Largest parameter kept. Bigger ones are clamped, which is fine since none
+ * of the supported sequences needs more.
+ */
+#define MAX_PARAM 255
+
+static uint8_t
+ring_line(const struct ssd1306_vt *vt, uint8_t row)
+{
+    return (uint8_t)((vt->console.top + row) % vt->console.ring_lines);
+}
+
+/**
+ * Marks a line of the ring clean and blank, the way the console leaves lines
+ * it clears.
+ */
+static void
+blank_line(struct ssd1306_vt *vt, uint8_t line)
+{
+    memset(vt->chars[line], ' ', sizeof(vt->chars[line]));
+    memset(vt->attrs[line], 0, sizeof(vt->attrs[line]));
+
+    vt->dirty_first[line] = UINT8_MAX;
+    vt->dirty_last[line] = 0;
+}
+
+/**
+ * Stores a character in a cell, marking it dirty if it changed.
+ */
+static void
+put_cell(struct ssd1306_vt *vt, uint8_t row, uint8_t col, uint8_t c,
+         uint8_t attr)
+{
+    uint8_t line = ring_line(vt, row);
+
+    if (vt->chars[line][col] == c && vt->attrs[line][col] == attr) {
+        return;
+    }
+
+    vt->chars[line][col] = c;
+    vt->attrs[line][col] = attr;
+
+    if (col < vt->dirty_first[line]) {
+        vt->dirty_first[line] = col;
+    }
+    if (col > vt->dirty_last[line]) {
+        vt->dirty_last[line] = col;
+    }
+}
+
+static void
+erase_cells(struct ssd1306_vt *vt, uint8_t row, uint8_t first_col,
+            uint8_t last_col)
+{
+    for (uint8_t col = first_col; col <= last_col; col++) {
+        put_cell(vt, row, col, ' ', 0);
+    }
+}
+
+enum ssd1306_err
+ssd1306_vt_init(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (vt == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+
+    SSD1306_RETURN_ON_ERR(ssd1306_console_init(ctx, &vt->console));
+
+    if (vt->console.cols > SSD1306_VT_MAX_COLS) {
+        return SSD1306_OUT_OF_DIMENSION;
+    }
+
+    for (uint8_t line = 0; line < SSD1306_FB_MAX_PAGES; line++) {
+        blank_line(vt, line);
+    }
+
+    vt->attr = 0;
+    vt->state = SSD1306_VT_GROUND;
+
+    return SSD1306_OK;
+}
+
+/**
+ * Moves the cursor to the start of the next line, scrolling at the bottom.
+ */
+static enum ssd1306_err
+new_line(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt)
+{
+    struct ssd1306_console *console = &vt->console;
+
+    console->cursor_col = 0;
+
+    if (console->cursor_row + 1 < console->rows) {
+        console->cursor_row++;
+        return SSD1306_OK;
+    }
+
+    /* The console clears the line that scrolls in itself. */
+    blank_line(vt, ring_line(vt, console->rows));
+
+    return ssd1306_console_scroll(ctx, console);
+}
+
+static enum ssd1306_err
+print(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt, uint8_t c)
+{
+    struct ssd1306_console *console = &vt->console;
+    const uint8_t *glyph;
+
+    if (ssd1306_find_glyph(console->font, c, &glyph) != SSD1306_OK) {
+        c = '?';
+    }
+
+    /* The cursor sits past the last column until the next character. */
+    if (console->cursor_col == console->cols) {
+        SSD1306_RETURN_ON_ERR(new_line(ctx, vt));
+    }
+
+    put_cell(vt, console->cursor_row, console->cursor_col, c, vt->attr);
+    console->cursor_col++;
+
+    return SSD1306_OK;
+}
+
+static enum ssd1306_err
+control(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt, uint8_t c)
+{
+    struct ssd1306_console *console = &vt->console;
+
+    switch (c) {
+        case '\n':
+            return new_line(ctx, vt);
+        case '\r':
+            console->cursor_col = 0;
+            break;
+        case '\b':
+            if (console->cursor_col > 0) {
+                console->cursor_col--;
+            }
+            break;
+        case '\t':
+            console->cursor_col =
+                (uint8_t)((console->cursor_col / TAB_WIDTH + 1) * TAB_WIDTH);
+            if (console->cursor_col >= console->cols) {
+                console->cursor_col = (uint8_t)(console->cols - 1);
+            }
+            break;
+        case ESC:
+            vt->state = SSD1306_VT_ESCAPE;
+            break;
+        default:
+            /* Bells and the like. */
+            break;
+    }
+
+    return SSD1306_OK;
+}
+
+/**
+ * Returns parameter @c i of the sequence, or @c def if it's missing or 0.
+ */
+static uint16_t
+param(const struct ssd1306_vt *vt, uint8_t i, uint16_t def)
+{
+    if (i >= vt->num_params || i >= SSD1306_VT_MAX_PARAMS
+        || vt->params[i] == 0) {
+        return def;
+    }
+
+    return vt->params[i];
+}
+
+static uint8_t
+clamp(int value, uint8_t max)
+{
+    if (value < 0) {
+        return 0;
+    }
+    else if (value > max) {
+        return max;
+    }
+
+    return (uint8_t)value;
+}
+
+/**
+ * Handles ESC[nJ. The console's rows are erased one line at a time, so only
+ * the cells that held something get redrawn.
+ */
+static void
+erase_in_screen(struct ssd1306_vt *vt, uint16_t mode)
+{
+    struct ssd1306_console *console = &vt->console;
+    uint8_t last_col = (uint8_t)(console->cols - 1);
+    uint8_t col = clamp(console->cursor_col, last_col);
+
+    for (uint8_t row = 0; row < console->rows; row++) {
+        if (mode == 0 && row == console->cursor_row) {
+            erase_cells(vt, row, col, last_col);
+        }
+        else if (mode == 1 && row == console->cursor_row) {
+            erase_cells(vt, row, 0, col);
+        }
+        else if (mode == 2 || (mode == 0 && row > console->cursor_row)
+                 || (mode == 1 && row < console->cursor_row)) {
+            erase_cells(vt, row, 0, last_col);
+        }
+    }
+}
+
+static void
+erase_in_line(struct ssd1306_vt *vt, uint16_t mode)
+{
+    struct ssd1306_console *console = &vt->console;
+    uint8_t last_col = (uint8_t)(console->cols - 1);
+    uint8_t col = clamp(console->cursor_col, last_col);
+
+    if (mode == 0) {
+        erase_cells(vt, console->cursor_row, col, last_col);
+    }
+    else if (mode == 1) {
+        erase_cells(vt, console->cursor_row, 0, col);
+    }
+    else if (mode == 2) {
+        erase_cells(vt, console->cursor_row, 0, last_col);
+    }
+}
+
+static void
+select_graphic_rendition(struct ssd1306_vt *vt)
+{
+    /* ESC[m is ESC[0m. */
+    uint8_t count = vt->num_params == 0 ? 1 : vt->num_params;
+
+    for (uint8_t i = 0; i < count && i < SSD1306_VT_MAX_PARAMS; i++) {
+        uint16_t p = i < vt->num_params ? vt->params[i] : 0;
+
+        if (p == 0 || p == 27) {
+            vt->attr &= (uint8_t)~SSD1306_VT_ATTR_REVERSE;
+        }
+        else if (p == 7) {
+            vt->attr |= SSD1306_VT_ATTR_REVERSE;
+        }
+    }
+}
+
+static void
+dispatch_csi(struct ssd1306_vt *vt, uint8_t final)
+{
+    struct ssd1306_console *console = &vt->console;
+    uint8_t last_row = (uint8_t)(console->rows - 1);
+    uint8_t last_col = (uint8_t)(console->cols - 1);
+    /* Relative moves start from the last column when a wrap is pending. */
+    int row = console->cursor_row;
+    int col = clamp(console->cursor_col, last_col);
+
+    if (vt->private_seq) {
+        return;
+    }
+
+    switch (final) {
+        case 'H':
+        case 'f':
+            console->cursor_row = clamp(param(vt, 0, 1) - 1, last_row);
+            console->cursor_col = clamp(param(vt, 1, 1) - 1, last_col);
+            break;
+        case 'A':
+            console->cursor_row = clamp(row - param(vt, 0, 1), last_row);
+            break;
+        case 'B':
+            console->cursor_row = clamp(row + param(vt, 0, 1), last_row);
+            break;
+        case 'C':
+            console->cursor_col = clamp(col + param(vt, 0, 1), last_col);
+            break;
+        case 'D':
+            console->cursor_col = clamp(col - param(vt, 0, 1), last_col);
+            break;
+        case 'J':
+            erase_in_screen(vt, vt->num_params == 0 ? 0 : vt->params[0]);
+            break;
+        case 'K':
+            erase_in_line(vt, vt->num_params == 0 ? 0 : vt->params[0]);
+            break;
+        case 'm':
+            select_graphic_rendition(vt);
+            break;
+        default:
+            break;
+    }
+}
+
+static void
+parse_csi(struct ssd1306_vt *vt, uint8_t c)
+{
+    if (c >= '0' && c <= '9') {
+        if (vt->num_params == 0) {
+            vt->num_params = 1;
+        }
+
+        uint8_t i = (uint8_t)(vt->num_params - 1);
+
+        if (i < SSD1306_VT_MAX_PARAMS) {
+            uint16_t p = (uint16_t)(vt->params[i] * 10 + (c - '0'));
+
+            vt->params[i] = p > MAX_PARAM ? MAX_PARAM : p;
+        }
+    }
+    else if (c == ';') {
+        /* An empty parameter before the ';' is a 0. */
+        if (vt->num_params == 0) {
+            vt->num_params = 1;
+        }
+        if (vt->num_params < UINT8_MAX) {
+            vt->num_params++;
+        }
+    }
+    else if (c >= 0x3C && c <= 0x3F) {
+        vt->private_seq = true;
+    }
+    else if (c >= 0x40 && c <= 0x7E) {
+        dispatch_csi(vt, c);
+        vt->state = SSD1306_VT_GROUND;
+    }
+    /* Intermediate bytes are skipped. */
+}
+
+static enum ssd1306_err
+parse(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt, uint8_t c)
+{
+    /* Control characters act even in the middle of a sequence. */
+    if (c == ESC || c == '\n' || c == '\r' || c == '\b' || c == '\t') {
+        return control(ctx, vt, c);
+    }
+    else if (c < 0x20 || c == 0x7F) {
+        return SSD1306_OK;
+    }
+
+    switch (vt->state) {
+        case SSD1306_VT_ESCAPE:
+            if (c == '[') {
+                vt->state = SSD1306_VT_CSI;
+                vt->private_seq = false;
+                vt->num_params = 0;
+                memset(vt->params, 0, sizeof(vt->params));
+            }
+            else {
+                /* Two byte sequences, ignored. */
+                vt->state = SSD1306_VT_GROUND;
+            }
+            return SSD1306_OK;
+        case SSD1306_VT_CSI:
+            parse_csi(vt, c);
+            return SSD1306_OK;
+        default:
+            return print(ctx, vt, c);
+    }
+}
+
+/**
+ * Redraws the dirty cells, a run of cells with the same attributes at a time.
+ */
+static enum ssd1306_err
+redraw(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt)
+{
+    for (uint8_t row = 0; row < vt->console.rows; row++) {
+        uint8_t line = ring_line(vt, row);
+        uint8_t col = vt->dirty_first[line];
+        uint8_t last_col = vt->dirty_last[line];
+
+        while (col <= last_col) {
+            uint8_t attr = vt->attrs[line][col];
+            uint8_t end = col;
+
+            while (end < last_col && vt->attrs[line][end + 1] == attr) {
+                end++;
+            }
+
+            SSD1306_RETURN_ON_ERR(ssd1306_console_draw(
+                ctx, &vt->console, row, col, &vt->chars[line][col],
+                (size_t)(end - col + 1), attr & SSD1306_VT_ATTR_REVERSE));
+
+            col = (uint8_t)(end + 1);
+        }
+
+        vt->dirty_first[line] = UINT8_MAX;
+        vt->dirty_last[line] = 0;
+    }
+
+    return SSD1306_OK;
+}
+
+enum ssd1306_err
+ssd1306_vt_feed(struct ssd1306_ctx *ctx, struct ssd1306_vt *vt,
+                const uint8_t *data, size_t len)
+{
+    if (ctx == NULL) {
+        return SSD1306_CTX_NULL;
+    }
+    else if (vt == NULL || data == NULL) {
+        return SSD1306_DATA_LIST_NULL;
+    }
+    /* Checked up front so the cells aren't left out of step with the RAM. */
+    else if (ssd1306_is_portrait(ctx)) {
+        return SSD1306_ROTATION_UNSUPPORTED;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        SSD1306_RETURN_ON_ERR(parse(ctx, vt, data[i]));
+    }
+
+    return redraw(ctx, vt);
+}
@@ -0,0 +1,187 @@
+#include "window.h"
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/fb.h"
+#include "ssd1306/platform.h"
+#include "ssd1306/ssd1306.h"
+
+#include <stdbool.h>
+#include <stddef.h> /* NULL, size_t */
+#include <stdint.h>
+
+/**
+ * Value of @ref ssd1306_spans::first for a clean page. Any value greater
+ * than the last column works.
+ */
+#define CLEAN_FIRST 0xFF
+
+/**
+ * Value of @ref ssd1306_spans::last for a clean page.
+ */
+#define CLEAN_LAST 0x00
+
+/**
+ * Prices every byte, command or data, at 1. Used when the caller doesn't
+ * supply a model.
+ */
+static const struct ssd1306_bus_model unit_bus = {1, 0};
+
+void
+ssd1306_spans_mark_dirty(const struct ssd1306_spans *spans, int16_t x,
+                         int16_t y, int16_t w, int16_t h)
+{
+    long height = (long)spans->num_pages * SSD1306_ROWS_PER_PAGE;
+    /* Widen before clipping so x + w can't overflow. */
+    long first_x = x < 0 ? 0 : x;
+    long last_x = (long)x + w - 1;
+    long first_y = y < 0 ? 0 : y;
+    long last_y = (long)y + h - 1;
+
+    if (last_x >= spans->width) {
+        last_x = spans->width - 1;
+    }
+
+    if (last_y >= height) {
+        last_y = height - 1;
+    }
+
+    if (first_x > last_x || first_y > last_y) {
+        return;
+    }
+
+    for (long page = first_y / SSD1306_ROWS_PER_PAGE;
+         page <= last_y / SSD1306_ROWS_PER_PAGE; page++) {
+        if (first_x < spans->first[page]) {
+            spans->first[page] = (uint8_t)first_x;
+        }
+
+        if (last_x > spans->last[page]) {
+            spans->last[page] = (uint8_t)last_x;
+        }
+    }
+}
+
+void
+ssd1306_spans_mark_all_dirty(const struct ssd1306_spans *spans)
+{
+    for (uint8_t page = 0; page < spans->num_pages; page++) {
+        spans->first[page] = 0;
+        spans->last[page] = (uint8_t)(spans->width - 1);
+    }
+}
+
+void
+ssd1306_spans_mark_clean(const struct ssd1306_spans *spans)
+{
+    for (uint8_t page = 0; page < spans->num_pages; page++) {
+        spans->first[page] = CLEAN_FIRST;
+        spans->last[page] = CLEAN_LAST;
+    }
+}
+
+bool
+ssd1306_spans_is_dirty(const struct ssd1306_spans *spans, uint8_t page)
+{
+    return spans->first[page] <= spans->last[page];
+}
+
+uint32_t
+ssd1306_window_ns(const struct ssd1306_spans *spans,
+                  const struct ssd1306_bus_model *bus,
+                  const struct ssd1306_window *window)
+{
+    size_t cols = (size_t)(window->last_col - window->first_col + 1);
+    size_t pages = (size_t)(window->last_page - window->first_page + 1);
+    size_t page_bytes = cols * spans->col_bytes;
+
+    if (bus == NULL) {
+        bus = &unit_bus;
+    }
+
+    uint64_t ns = ssd1306_bus_cmd_ns(bus, SSD1306_WINDOW_CMD_LEN);
+
+    if (cols == spans->width) {
+        ns += ssd1306_bus_data_ns(bus, page_bytes * pages);
+    }
+    else {
+        ns += (uint64_t)pages * ssd1306_bus_data_ns(bus, page_bytes);
+    }
+
+    return ns > UINT32_MAX ? UINT32_MAX : (uint32_t)ns;
+}
+
+uint32_t
+ssd1306_window_grow(const struct ssd1306_spans *spans,
+                    const struct ssd1306_bus_model *bus, uint8_t page,
+                    ssd1306_window_fits_cb fits, const void *user,
+                    struct ssd1306_window *window)
+{
+    window->first_page = page;
+    window->last_page = page;
+    window->first_col = spans->first[page];
+    window->last_col = spans->last[page];
+
+    uint32_t cost = ssd1306_window_ns(spans, bus, window);
+
+    for (uint8_t next = page + 1;
+         next < spans->num_pages && ssd1306_spans_is_dirty(spans, next);
+         next++) {
+        struct ssd1306_window alone = {
+            next,
+            next,
+            spans->first[next],
+            spans->last[next],
+        };
+        struct ssd1306_window merged = {
+            window->first_page,
+            next,
+            alone.first_col < window->first_col ? alone.first_col
+                                                : window->first_col,
+            alone.last_col > window->last_col ? alone.last_col
+                                              : window->last_col,
+        };
+        uint32_t merged_cost = ssd1306_window_ns(spans, bus, &merged);
+        uint64_t split_cost =
+            (uint64_t)cost + ssd1306_window_ns(spans, bus, &alone);
+
+        if (merged_cost > split_cost
+            || (fits != NULL && !fits(user, &merged, merged_cost))) {
+            break;
+        }
+
+        *window = merged;
+        cost = merged_cost;
+    }
+
+    return cost;
+}
+
+enum ssd1306_err
+ssd1306_window_write(struct ssd1306_ctx *ctx, const uint8_t *buf,
+                     uint16_t stride, uint8_t ram_page,
+                     const struct ssd1306_window *window)
+{
+    size_t cols = (size_t)(window->last_col - window->first_col + 1);
+
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_col_range(ctx, window->first_col, window->last_col));
+    SSD1306_RETURN_ON_ERR(
+        ssd1306_set_page_range(ctx, ram_page + window->first_page,
+                               ram_page + window->last_page));
+
+    /* Full width windows are contiguous in the buffer. */
+    if (cols == stride) {
+        return ssd1306_write_data_list(
+            ctx, &buf[(size_t)window->first_page * stride],
+            cols * (size_t)(window->last_page - window->first_page + 1));
+    }
+
+    for (uint8_t page = window->first_page; page <= window->last_page;
+         page++) {
+        SSD1306_RETURN_ON_ERR(ssd1306_write_data_list(
+            ctx, &buf[(size_t)page * stride + window->first_col], cols));
+    }
+
+    return SSD1306_OK;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file
+ *
+ * Tracking of dirty columns, grouping of them into windows of the display's
+ * RAM and sending those windows, shared by the buffers and their flushes.
+ * Internal to the library.
+ */
+
+#ifndef LIBSSD1306_SRC_WINDOW_H
+#define LIBSSD1306_SRC_WINDOW_H
+
+#include "ssd1306/bus.h"
+#include "ssd1306/err.h"
+#include "ssd1306/platform.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Columns of each page of a buffer that need sending.
+ */
+struct ssd1306_spans {
+    /**
+     * First column to send of each page.
+     */
+    uint8_t *first;
+    /**
+     * Last column to send of each page. A page is clean when it's less than
+     * the page's @c first.
+     */
+    uint8_t *last;
+    /**
+     * Number of pages.
+     */
+    uint8_t num_pages;
+    /**
+     * Columns in a page. Windows this wide are contiguous in the buffer and
+     * are sent as a single list.
+     */
+    uint16_t width;
+    /**
+     * Data bytes sent per column of a page: 1, or 8 when a column stands for
+     * an 8x8 block that's transposed on the way out.
+     */
+    uint8_t col_bytes;
+};
+
+/**
+ * Pages and columns of a window, in the units of a @ref ssd1306_spans.
+ */
+struct ssd1306_window {
+    uint8_t first_page;
+    uint8_t last_page;
+    uint8_t first_col;
+    uint8_t last_col;
+};
+
+/**
+ * Tells @ref ssd1306_window_grow whether a grown window is still acceptable.
+ *
+ * @param user   passed to @ref ssd1306_window_grow
+ * @param window the grown window
+ * @param ns     time the grown window takes to send
+ */
+typedef bool (*ssd1306_window_fits_cb)(const void *user,
+                                       const struct ssd1306_window *window,
+                                       uint32_t ns);
+
+/**
+ * Adds a rectangle to the spans. The rectangle is clipped to the buffer.
+ *
+ * @param spans spans to grow
+ * @param x     leftmost column, may be negative
+ * @param y     top row, may be negative
+ * @param w     width in columns
+ * @param h     height in rows
+ */
+void ssd1306_spans_mark_dirty(const struct ssd1306_spans *spans, int16_t x,
+                              int16_t y, int16_t w, int16_t h);
+
+/**
+ * Makes every column of every page dirty.
+ */
+void ssd1306_spans_mark_all_dirty(const struct ssd1306_spans *spans);
+
+/**
+ * Makes every page clean.
+ */
+void ssd1306_spans_mark_clean(const struct ssd1306_spans *spans);
+
+/**
+ * Returns whether @c page has columns to send.
+ */
+bool ssd1306_spans_is_dirty(const struct ssd1306_spans *spans, uint8_t page);
+
+/**
+ * Estimates how long sending a window takes, window commands included.
+ *
+ * @param spans  buffer the window is in
+ * @param bus    bus model, @c NULL to price every byte at 1
+ * @param window window to price
+ *
+ * @return the time, in nanoseconds, saturated to @c UINT32_MAX
+ */
+uint32_t ssd1306_window_ns(const struct ssd1306_spans *spans,
+                           const struct ssd1306_bus_model *bus,
+                           const struct ssd1306_window *window);
+
+/**
+ * Opens a window on a dirty page and grows it downwards while sending the
+ * union of the spans is cheaper than opening a window for the next page.
+ *
+ * @param spans  buffer to flush
+ * @param bus    bus model, @c NULL to price every byte at 1
+ * @param page   dirty page to start at
+ * @param fits   **optional**, stops the window from growing when it returns
+ *               @c false
+ * @param user   passed to @c fits
+ * @param window set to the window
+ *
+ * @return the time the window takes to send, see @ref ssd1306_window_ns
+ */
+uint32_t ssd1306_window_grow(const struct ssd1306_spans *spans,
+                             const struct ssd1306_bus_model *bus, uint8_t page,
+                             ssd1306_window_fits_cb fits, const void *user,
+                             struct ssd1306_window *window);
+
+/**
+ * Sends a window of a page-major buffer to the display.
+ *
+ * @param ctx      struct that contains the platform dependent I/O
+ * @param buf      buffer, page @c p starts at @c buf[p * stride]
+ * @param stride   bytes from one page of @c buf to the next
+ * @param ram_page page of the display's RAM that page 0 of @c buf goes to
+ * @param window   window to send
+ */
+enum ssd1306_err ssd1306_window_write(struct ssd1306_ctx *ctx,
+                                      const uint8_t *buf, uint16_t stride,
+                                      uint8_t ram_page,
+                                      const struct ssd1306_window *window);
+
+#endif /* LIBSSD1306_SRC_WINDOW_H */